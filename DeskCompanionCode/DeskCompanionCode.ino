@@ -3,9 +3,10 @@
 #include <ESP32Encoder.h>
 #include <Wire.h>
 #include <NimBLEDevice.h>
-#include <DHT.h>
 #include <Adafruit_ADXL345_U.h>
+#include <atomic>
 
+#include <packed_sprite.h>
 #include <icons.h>
 #include <rotating_music_note_16_frames.h>
 
@@ -14,6 +15,31 @@ U8G2_SH1106_128X64_NONAME_F_HW_I2C u8g2(U8G2_R0);
 static const int SCREEN_WIDTH = 128;
 static const int SCREEN_HEIGHT = 64;
 
+// === Display Flush ===
+// Shadow of what the panel currently shows; sendFrame() only sends 8x8 tiles that differ.
+#define DISPLAY_FLUSH_STATS 0   // 1 = print bytes sent per frame over Serial
+static const int DISPLAY_PAGES = SCREEN_HEIGHT / 8;
+static const int DISPLAY_TILE_COLS = SCREEN_WIDTH / 8;
+static const int FLUSH_MERGE_GAP = 1;  // merge spans separated by <= 1 unchanged tile
+uint8_t displayShadow[SCREEN_WIDTH * DISPLAY_PAGES];
+bool displayShadowValid = false;
+unsigned long flushBytesLastFrame = 0;
+unsigned long flushBytesTotal = 0;
+unsigned long flushFrameCount = 0;
+
+// Double buffering: loop() draws into one frame while displayTask on core 0
+// sends the other over I2C. frameSlots packs the pending frame (low nibble)
+// and the frame being flushed (high nibble) so both change in one CAS.
+#define FRAME_NONE 0x0F
+uint8_t frameBuffers[2][SCREEN_WIDTH * DISPLAY_PAGES];
+uint8_t drawFrameIndex = 0;
+std::atomic<uint8_t> frameSlots(FRAME_NONE << 4 | FRAME_NONE);
+std::atomic<int> requestedContrast(-1);
+TaskHandle_t displayTaskHandle = nullptr;
+TaskHandle_t renderTaskHandle = nullptr;
+
+void flushDisplay();
+
 // === States ===
 enum AppState {
   IDLE,
@@ -83,14 +109,40 @@ ESP32Encoder encoder1;
 ESP32Encoder encoder2;
 int encoder1Pos = 0;
 int encoder2Pos = 0;
-bool encoder1BtnPressed = false;
-bool encoder2BtnPressed = false;
-bool encoder1LongPress = false;
-bool encoder2LongPress = false;
-unsigned long encoder1BtnStart = 0;
-unsigned long encoder2BtnStart = 0;
 const unsigned long LONG_PRESS_TIME = 500;  // 0.5s second
-const unsigned long debounceDelay = 200;     // debounce time (ms)
+const unsigned long BUTTON_DEBOUNCE = 30;   // edges closer than this are contact bounce
+
+// === Input Events ===
+// Button ISRs and the rotation poll push timestamped events here; checkEncoders()
+// classifies clicks and long presses from the timestamps, not from loop timing.
+enum InputEventType : uint8_t {
+  INPUT_PRESS,
+  INPUT_RELEASE,
+  INPUT_ROTATE
+};
+struct InputEvent {
+  uint8_t encoder;     // 0 = encoder 1, 1 = encoder 2
+  InputEventType type;
+  int16_t steps;       // INPUT_ROTATE only
+  uint32_t time;       // millis() when it happened
+};
+struct ButtonState {
+  bool pressed;
+  bool longPressFired;
+  uint32_t pressTime;
+  uint32_t lastEdge;
+};
+#define INPUT_QUEUE_SIZE 32
+InputEvent inputQueue[INPUT_QUEUE_SIZE];
+volatile uint8_t inputHead = 0;
+volatile uint8_t inputTail = 0;
+volatile uint32_t inputDropped = 0;
+portMUX_TYPE inputMux = portMUX_INITIALIZER_UNLOCKED;
+ButtonState buttons[2];
+
+void IRAM_ATTR encoder1ButtonISR();
+void IRAM_ATTR encoder2ButtonISR();
+void IRAM_ATTR enqueueInputEvent(const InputEvent& event);
 
 // === PIR Sensor ===
 #define PIR_PIN 35
@@ -99,26 +151,169 @@ unsigned long lastMotionTime = 0;
 const unsigned long SLEEP_DELAY = 20000;  // 20 seconds
 bool isAsleep = false;
 
+// === Wake Sources ===
+// PIR edges and the ADXL345 activity interrupt only set a flag and end the
+// frame-pacing wait; handleWakeSources() does the pin and I2C reads in loop().
+#define ADXL_INT_PIN 34            // ADXL345 INT1, active high
+#define ADXL_ACTIVITY_THRESHOLD 4  // THRESH_ACT in 62.5 mg steps
+#define ADXL_ACT_AC_XYZ 0xF0       // ACT_INACT_CTL: ac-coupled activity on X, Y and Z
+#define ADXL_INT_ACTIVITY 0x10     // INT_ENABLE / INT_SOURCE activity bit
+volatile bool pirChanged = false;
+volatile bool accelActivity = false;
+
+void IRAM_ATTR pirISR();
+void IRAM_ATTR accelActivityISR();
+
 // === Sensors ===
-DHT dht(DHT_PIN, DHT11);
 Adafruit_ADXL345_Unified adxl = Adafruit_ADXL345_Unified(12345);
+bool accelReady = false;
+
+// Written by dhtTask, picked up by readSensors() under dhtMux
+portMUX_TYPE dhtMux = portMUX_INITIALIZER_UNLOCKED;
+float dhtTemperature = NAN, dhtHumidity = NAN;
+uint32_t dhtSampleCount = 0;
+uint32_t dhtSamplesSeen = 0;
+
+// === DHT11 Edge Capture ===
+// After the start pulse the DHT11 pulls the line low before its 80 us preamble,
+// before each of its 40 bits and at the end. The pin interrupt only timestamps
+// those falling edges; a bit lasts ~78 us for a 0 and ~120 us for a 1 from one
+// falling edge to the next. Interrupts stay on and dhtTask sleeps through the read.
+#define DHT_EDGES 42  // preamble, 40 bits, end of frame
+const unsigned long DHT_START_MS = 20;  // host start pulse, 18 ms minimum
+const unsigned long DHT_FRAME_MS = 8;   // the whole reply takes under 5.5 ms
+const uint32_t DHT_ONE_US = 100;        // bit period above this is a 1
+volatile uint32_t dhtEdges[DHT_EDGES];
+volatile uint8_t dhtEdgeCount = 0;
+
+void IRAM_ATTR dhtEdgeISR();
+
+#define ADXL_FIFO_STREAM 0x80      // FIFO_CTL mode bits: keep the newest 32 samples
+#define ADXL_FIFO_ENTRIES_MASK 0x3F
 
 // === Display & Animation Timing ===
-unsigned long lastEyeAnim = 0;
 const unsigned long eyeAnimInterval = 4000;
 unsigned long lastLookAround = 0;
 unsigned long lookAroundInterval = 3000;
 float lookOffsetX = 0, lookOffsetY = 0;
-unsigned long lastAccelRead = 0;
-const unsigned long accelReadInterval = 50;
-unsigned long lastTempRead = 0;
+const unsigned long accelReadInterval = 160;  // drain ~4 FIFO samples at 25 Hz
+const float TILT_FILTER_ALPHA = 0.3;          // low-pass, ~2 Hz cutoff at 25 Hz
+float filteredTiltX = 0, filteredTiltY = 0;
 const unsigned long tempReadInterval = 5000;
+const float TILT_EPSILON = 0.02;  // ignore tilt changes smaller than ~0.2px of eye movement
+
+// === Profiler ===
+// Cycle-count histograms per loop phase and per face, reported by the STATS
+// command over Serial and BLE. With ENABLE_PROFILER 0, PROFILE() is just the
+// statement and no profiler state exists.
+#define ENABLE_PROFILER 0
+#define PROFILE_BUCKETS 32  // bucket i counts samples of 2^i..2^(i+1)-1 cycles
+enum ProfilePhase : uint8_t {
+  PHASE_LOOP,
+  PHASE_BLE,
+  PHASE_INPUT,
+  PHASE_TASKS,    // scheduled tasks
+  PHASE_STATE,    // state logic + render
+  PHASE_SENSORS,
+  PHASE_SEEK,
+  PHASE_FACE,     // + AppState of the face being rendered
+  PHASE_COUNT = PHASE_FACE + GAMES + 1
+};
+
+#if ENABLE_PROFILER
+const unsigned long STATS_REPORT_INTERVAL = 10000;  // STATS pushed over BLE while connected
+const char* const profilePhaseNames[PHASE_COUNT] = {
+  "loop", "ble", "input", "tasks", "state", "sensors", "seek",
+  "idle", "clock face", "music", "notifs", "timer", "events", "menu", "popup", "sleep", "games"
+};
+struct ProfileHistogram {
+  uint32_t buckets[PROFILE_BUCKETS];
+  uint32_t count;
+  uint32_t max;
+};
+ProfileHistogram profileHistograms[PHASE_COUNT];
+unsigned long profileWindowStart = 0;
+unsigned long profileFramesAtStart = 0;
+
+struct ProfileScope {
+  uint8_t phase;
+  uint32_t start;
+
+  explicit ProfileScope(uint8_t phase) : phase(phase), start(ESP.getCycleCount()) {}
+
+  ~ProfileScope() {
+    uint32_t cycles = ESP.getCycleCount() - start;
+    ProfileHistogram& histogram = profileHistograms[phase];
+    histogram.buckets[cycles ? 31 - __builtin_clz(cycles) : 0]++;
+    histogram.count++;
+    if (cycles > histogram.max) histogram.max = cycles;
+  }
+};
+#define PROFILE(phase, statement) do { ProfileScope profileScope(phase); statement; } while (0)
+#else
+#define PROFILE(phase, statement) statement
+#endif
+
+// === Render Scheduling ===
+// Each face declares which inputs it shows; handleState() only redraws when one of
+// them was invalidated, the state changed, or the face's own deadline has passed.
+enum RenderDependency {
+  DEP_INPUT         = 1 << 0,  // encoder rotation / clicks
+  DEP_CLOCK         = 1 << 1,  // clock second ticked or time synced
+  DEP_SENSORS       = 1 << 2,  // temperature / humidity
+  DEP_TILT          = 1 << 3,  // accelerometer tilt
+  DEP_MUSIC         = 1 << 4,  // song metadata / playback state
+  DEP_NOTIFICATIONS = 1 << 5,  // notification list
+  DEP_EVENTS        = 1 << 6,  // events list
+  DEP_TIMER         = 1 << 7,  // timer substate changed
+  DEP_ALL           = 0xFFFF
+};
+uint16_t renderDirty = DEP_ALL;
+unsigned long renderDeadline = 0;
+bool renderDeadlineSet = false;
+AppState lastRenderedState = IDLE;
+const unsigned long MUSIC_SCROLL_INTERVAL = 30;  // ms per pixel of title scroll
+
+// === Scheduler ===
+// Timed background work sits in a min-heap ordered by deadline. runDueTasks() runs
+// only what is due, and the frame pacer sleeps until the top deadline. A callback
+// is its own id: scheduling one that is already queued moves it.
+typedef void (*TaskCallback)();
+struct ScheduledTask {
+  unsigned long deadline;
+  unsigned long period;  // 0 = one-shot
+  TaskCallback callback;
+};
+#define MAX_SCHEDULED_TASKS 12
+ScheduledTask taskHeap[MAX_SCHEDULED_TASKS];
+uint8_t taskCount = 0;
+
+// === Frame Pacing ===
+// After each pass loop() blocks until the earliest deadline any part of the
+// device is waiting on, so idle faces let the CPU halt instead of spinning.
+// Button, encoder, PIR and BLE activity give wakeSignal to end the wait early.
+const unsigned long PACER_MAX_SLEEP = 100;  // bounds anything polled without a deadline (alarm beeps, Serial)
+const unsigned long PACER_ASLEEP_MAX = 60000;  // while asleep only interrupts and BLE have work
+SemaphoreHandle_t wakeSignal = nullptr;
+
+void IRAM_ATTR wakeLoopFromISR();
+
+// === Ambient Light ===
+// The LDR divider reads higher in brighter light. The smoothed reading maps through
+// a perceptual curve to panel contrast; small changes are ignored to avoid flicker.
+const unsigned long LDR_INTERVAL = 500;
+const int LDR_HYSTERESIS = 8;
+const uint8_t AMBIENT_CONTRAST_CURVE[9] = { 8, 16, 32, 56, 88, 128, 168, 212, 255 };  // per 512 ADC counts
+float ambientLevel = -1;  // smoothed ADC reading, -1 until the first sample
+uint8_t ambientContrast = 255;
 
 // === Notification Popup ===
-unsigned long notificationPopupStart = 0;
+#define NOTIF_APP_MAX 32
+#define NOTIF_TITLE_MAX 64
+#define NOTIF_CONTENT_MAX 192
 const unsigned long NOTIFICATION_POPUP_DURATION = 5000;
 bool showNotificationPopup = false;
-String currentNotification = "";
+char currentNotification[NOTIF_APP_MAX + NOTIF_TITLE_MAX + 2] = "";
 
 // === Menu System ===
 const String faceNames[] = { "IDLE", "CLOCK", "MUSIC", "NOTIFS", "TIMER", "EVENTS", "SLEEP", "GAMES" };
@@ -137,15 +332,33 @@ const int timerMinutesPreset[] = {1, 2, 5, 10, 15, 20, 25, 30, 45, 60, 90, 120};
 const int timerPresets = 12;
 int timerMinutesIndex = 0;
 bool pomodoroOnBreak = false;
+const unsigned long POMODORO_AUTOSTART_DELAY = 2000;
+const unsigned long TIMER_ALARM_INTERVAL = 1000;
 
 // === Music Info ===
-String currentSong = "No Music";
-String currentAlbum = "";
-String currentArtist = "";
+#define MUSIC_TEXT_MAX 96  // bytes incl. terminator, UTF-8 truncated on a character boundary
+char currentSong[MUSIC_TEXT_MAX] = "No Music";
+char currentAlbum[MUSIC_TEXT_MAX] = "";
+char currentArtist[MUSIC_TEXT_MAX] = "";
 bool musicPlaying = false;
 int musicVolume = 50;
 int songDuration = 1000; // in ms
 int playbackPosition = 0;
+long playbackDrift = 0;              // ms of a position sync still to be absorbed
+const long MUSIC_DRIFT_SNAP = 2000;  // larger errors jump instead of slewing
+const unsigned long PLAYBACK_STEP = 16;
+
+// === Music Layout ===
+// Recomputed by layoutMusicText() only when the track changes
+#define MARQUEE_PAGES 3        // song title rows 0-23 (baseline 18)
+#define MARQUEE_MAX_WIDTH 640  // wider titles are cut off in the strip
+#define MARQUEE_GAP 20
+bool musicLayoutValid = false;
+int musicSongWidth = 0;
+int marqueePeriod = 0;         // strip width including the gap; 0 = title fits
+uint8_t marqueeStrip[MARQUEE_PAGES * MARQUEE_MAX_WIDTH];
+char musicAlbumLine[MUSIC_TEXT_MAX + 2];
+char musicArtistLine[MUSIC_TEXT_MAX + 2];
 
 // === Sensor Data ===
 float temperature = 0;
@@ -153,58 +366,555 @@ float humidity = 0;
 float tiltX = 0, tiltY = 0;
 
 // === Clock ===
-int currentHour = 0, currentMinute = 0, currentSecond = 0;
-unsigned long lastTimeSync = 0;   // millis of last sync
-unsigned long lastTick = 0;       // millis of last second update
+// Time of day is an anchor (ms of day at a known esp_timer reading) plus the time
+// elapsed since, corrected by the learned crystal error, so reading it is O(1) and
+// nothing has to tick while loop() sleeps. Each sync compares the phone's time
+// with the estimate since the drift reference to refine clockDriftPpm.
+#define MS_PER_DAY 86400000LL
+const int64_t CLOCK_DRIFT_MIN_SPAN = 1800000;  // ms a reference must age before it teaches the estimate
+const int64_t CLOCK_STEP_THRESHOLD = 2000;     // larger errors are a clock change (DST, zone), not drift
+const float CLOCK_DRIFT_MAX_PPM = 500;
+const float CLOCK_DRIFT_GAIN = 0.5;            // share of each measured residual taken into the estimate
+int64_t clockAnchorUs = 0;    // esp_timer_get_time() at the last sync
+int64_t clockAnchorMs = 0;    // ms of day at the last sync
+int64_t driftRefUs = 0;       // older sync the drift is measured against
+int64_t driftRefMs = 0;
+bool clockSynced = false;
+float clockDriftPpm = 0;      // true elapsed = device elapsed * (1 + ppm / 1e6)
 
 // === Notification System ===
+// Descriptors live in a ring, oldest first. Their text is packed as
+// "app\0title\0content\0" into a byte arena that is filled in the same
+// order, so evicting the oldest descriptor always frees the oldest bytes
+// and the arena never fragments.
+#define MAX_NOTIFICATIONS 48
+#define NOTIF_ARENA_SIZE 3072
 struct Notification {
-  String app;
-  String title;
-  String content;
+  uint16_t offset;        // start of the text block in notificationArena
+  uint16_t length;        // bytes used by the block
+  uint8_t titleStart;     // relative to offset
+  uint8_t contentStart;   // relative to offset
+  uint8_t repeats;        // times this app + title arrived
+  bool superseded;        // a newer copy with the same app + title exists
   unsigned long timestamp;
 };
-const int MAX_NOTIFICATIONS = 10;
 Notification notifications[MAX_NOTIFICATIONS];
-int notificationCount = 0;
+char notificationArena[NOTIF_ARENA_SIZE];
+int notificationHead = 0;           // ring index of the oldest descriptor
+int notificationSlots = 0;          // descriptors in the ring, superseded included
+uint16_t notificationArenaTail = 0; // next free byte in the arena
+int notificationCount = 0;          // visible notifications
 int notificationScrollPos = 0;
 
 // === Events ===
 #define MAX_EVENTS 10
 
-String eventNames[MAX_EVENTS];
+#define EVENT_NAME_MAX 32
+
+char eventNames[MAX_EVENTS][EVENT_NAME_MAX];
 int eventDurations[MAX_EVENTS]; // in minutes
 int numEvents = 0;
 int selectedEventIndex = 0;
 
 // === Pong Game Variables ===
+// Physics steps every PONG_TICK_MS on Q8 fixed-point state, so play is the same at
+// any frame rate and replays exactly from the rng seed and the per-tick inputs.
+#define PONG_FP_SHIFT 8
+#define PONG_FP(px) ((int32_t)((px) * (1 << PONG_FP_SHIFT)))
+#define PONG_TICK_MS 16
+#define PONG_MAX_TICKS 8  // ticks simulated per frame at most; longer stalls are dropped
+#define PONG_INPUT_SLOTS (PONG_MAX_TICKS + 1)  // one per tick a frame can cover
+
+// Encoder steps by the tick they arrived in, so a frame that runs several ticks
+// applies each step on the same tick a faster frame rate would
+struct PongInput {
+  uint32_t tick;
+  int16_t left, right;
+};
+
 struct PongGame {
-  float ballX, ballY;
-  float ballVelX, ballVelY;
-  float leftPaddleY, rightPaddleY;
+  int32_t ballX, ballY;            // Q8 pixels, ball centre
+  int32_t ballVelX, ballVelY;      // Q8 pixels per tick
+  int32_t ballSpeed;               // Q8 pixels per tick, grows with each paddle hit
+  int32_t leftPaddleY, rightPaddleY;
+  int32_t prevBallX, prevBallY, prevLeftPaddleY, prevRightPaddleY;  // before the last tick, for interpolation
+  PongInput inputs[PONG_INPUT_SLOTS];  // waiting for their tick, oldest first
+  uint8_t inputCount;
+  uint32_t tick;                   // ticks simulated since the game started
   int leftScore, rightScore;
   bool gameActive;
   unsigned long lastUpdate;
+  uint32_t accumulator;            // ms not yet simulated
+  uint32_t rng;                    // xorshift32 state
   
   // Game settings
   static const int PADDLE_HEIGHT = 20;
   static const int PADDLE_WIDTH = 3;
   static const int BALL_SIZE = 2;
-  static constexpr float BALL_SPEED = 2.0;
-  static constexpr float PADDLE_SPEED = 3.0;
+  static constexpr int32_t BALL_SPEED = PONG_FP(2);
+  static constexpr int32_t MAX_BALL_SPEED = PONG_FP(6);
+  static constexpr int32_t PADDLE_SPEED = PONG_FP(3);
+  static constexpr int32_t AI_SPEED = PONG_FP(2.1);  // slightly slower than the player
 } pongGame;
 
+// Q8 cos/sin of -60..60 degrees in 7.5 degree steps
+const int16_t PONG_ANGLE_COS[17] = { 128, 156, 181, 203, 222, 237, 247, 254, 256, 254, 247, 237, 222, 203, 181, 156, 128 };
+const int16_t PONG_ANGLE_SIN[17] = { -222, -203, -181, -156, -128, -98, -66, -33, 0, 33, 66, 98, 128, 156, 181, 203, 222 };
+
 // === BLE Setup ===
 #define SERVICE_UUID "fa974e39-7cab-4fa2-8681-1d71f9fb73bc"
 #define CHARACTERISTIC_RX "12e87612-7b69-4e34-a21b-d2303bfa2691"
 #define CHARACTERISTIC_TX "2b50f752-b04e-4c9f-b188-aa7d5cf93dab"
 NimBLECharacteristic* txChar;
 bool deviceConnected = false;
+volatile bool connectFeedbackPending = false;
+volatile bool disconnectFeedbackPending = false;
+
+// === BLE Receive Queue ===
+#define BLE_RX_SLOTS 8          // preallocated message slots
+#define BLE_RX_MSG_MAX 512      // bytes per slot, longer messages are truncated
+#define BLE_RX_DRAIN_BATCH 4    // messages handled per loop() pass
+struct BleRxSlot {
+  uint16_t length;
+  char data[BLE_RX_MSG_MAX + 1];
+};
+BleRxSlot bleRxSlots[BLE_RX_SLOTS];
+std::atomic<uint32_t> bleRxHead(0);  // written only by the NimBLE task
+std::atomic<uint32_t> bleRxTail(0);  // written only by loop()
+volatile uint32_t bleRxDropped = 0;
+
+// === BLE Fragments ===
+// A message longer than one write arrives as fragments, each prefixed with
+// [BLE_FRAGMENT_MAGIC][message id][index][count][total length, 2 bytes LE].
+// The NimBLE task reassembles them and queues the whole message; a write
+// without the magic is a complete message as before.
+#define BLE_FRAGMENT_MAGIC 0xDD
+#define BLE_FRAGMENT_HEADER 6
+#define BLE_PREFERRED_MTU 517  // most messages then fit one write
+const unsigned long BLE_FRAGMENT_TIMEOUT = 500;  // longest gap between fragments of one message
+struct BleReassembly {
+  bool active;
+  uint8_t id;
+  uint8_t nextIndex;
+  uint8_t count;
+  uint16_t total;
+  uint16_t received;
+  unsigned long lastFragmentAt;
+  uint8_t data[BLE_RX_MSG_MAX];
+};
+BleReassembly bleRxAssembly;  // touched only by the NimBLE task
+
+// === Binary Protocol ===
+// Frame: [BLE_FRAME_MAGIC][version][message type] then fields, each a tag byte
+// (field << 3 | wire type) followed by a varint or a varint length + UTF-8 bytes.
+// Text commands remain the fallback until the phone negotiates with "PROTO:1".
+#define BLE_FRAME_MAGIC 0xDC
+#define BLE_PROTOCOL_VERSION 1
+#define BLE_TX_MAX 256
+enum BleWireType {
+  WIRE_VARINT = 0,
+  WIRE_BYTES = 2
+};
+enum BleMessageType {
+  // phone -> device
+  MSG_NOTIFICATION = 0x01,  // 1 app, 2 title, 3 content
+  MSG_MUSIC = 0x02,         // 1 song, 2 album, 3 artist, 4 playing, 5 volume, 6 duration, 7 position
+  MSG_TIME = 0x03,          // 1 hour, 2 minute, 3 second, 4 millisecond
+  MSG_EVENTS = 0x04,        // repeated 1 name, 2 minutes
+  MSG_MUSIC_TRACK = 0x05,   // 1 song, 2 album, 3 artist, 4 duration
+  MSG_MUSIC_STATE = 0x06,   // 1 playing, 2 position
+  MSG_MUSIC_POSITION = 0x07,  // 1 position
+  // device -> phone
+  MSG_MUSIC_PLAY = 0x10,
+  MSG_MUSIC_PAUSE = 0x11,
+  MSG_MUSIC_NEXT = 0x12,
+  MSG_MUSIC_PREV = 0x13,
+  MSG_MUSIC_VOLUME = 0x14,         // 1 volume (also sent by the phone)
+  MSG_MUSIC_SEEK_RELATIVE = 0x15,  // 1 milliseconds (zigzag)
+  MSG_EVENT_COMPLETE = 0x16        // 1 event name
+};
+bool bleBinaryProtocol = false;  // negotiated per connection
+
+struct TextView {
+  const char* data;
+  size_t length;
+};
+
+// Reads the fields of one binary frame in place
+class FrameReader {
+public:
+  FrameReader(const uint8_t* data, size_t length) : pos(data), end(data + length) {}
+
+  // Advance to the next field; false at the end of the frame or on malformed input
+  bool next(uint8_t& field) {
+    if (pos >= end) return false;
+    uint8_t tag = *pos++;
+    field = tag >> 3;
+    wireType = tag & 0x07;
+    if (wireType == WIRE_VARINT) return readVarint(value);
+    if (wireType != WIRE_BYTES) return false;
+
+    uint32_t length;
+    if (!readVarint(length) || length > (uint32_t)(end - pos)) return false;
+    text = { (const char*)pos, length };
+    pos += length;
+    return true;
+  }
+
+  bool isText() const { return wireType == WIRE_BYTES; }
+  uint32_t unsignedValue() const { return value; }
+  int32_t signedValue() const { return (int32_t)(value >> 1) ^ -(int32_t)(value & 1); }
+  TextView textValue() const { return text; }
+
+private:
+  const uint8_t* pos;
+  const uint8_t* end;
+  uint8_t wireType = WIRE_VARINT;
+  uint32_t value = 0;
+  TextView text = { "", 0 };
+
+  bool readVarint(uint32_t& result) {
+    result = 0;
+    for (int shift = 0; shift < 35 && pos < end; shift += 7) {
+      uint8_t b = *pos++;
+      result |= (uint32_t)(b & 0x7F) << shift;
+      if (!(b & 0x80)) return true;
+    }
+    return false;
+  }
+};
+
+// Builds one outgoing binary frame in a fixed buffer
+class FrameWriter {
+public:
+  explicit FrameWriter(uint8_t type) {
+    buf[0] = BLE_FRAME_MAGIC;
+    buf[1] = BLE_PROTOCOL_VERSION;
+    buf[2] = type;
+    length = 3;
+  }
+
+  void putUnsigned(uint8_t field, uint32_t value) {
+    putByte(field << 3 | WIRE_VARINT);
+    putVarint(value);
+  }
+
+  void putSigned(uint8_t field, int32_t value) {
+    putUnsigned(field, ((uint32_t)value << 1) ^ (uint32_t)(value >> 31));
+  }
+
+  void putText(uint8_t field, const char* text) {
+    size_t textLength = strlen(text);
+    putByte(field << 3 | WIRE_BYTES);
+    putVarint(textLength);
+    for (size_t i = 0; i < textLength; i++) putByte(text[i]);
+  }
+
+  const uint8_t* data() const { return buf; }
+  size_t size() const { return length; }
+
+private:
+  uint8_t buf[BLE_TX_MAX];
+  size_t length;
+
+  void putByte(uint8_t b) {
+    if (length < BLE_TX_MAX) buf[length++] = b;
+  }
+
+  void putVarint(uint32_t value) {
+    while (value >= 0x80) {
+      putByte((value & 0x7F) | 0x80);
+      value >>= 7;
+    }
+    putByte(value);
+  }
+};
+
+// === Outbound Commands ===
+// Encoder commands go through queueBLECommand(), which coalesces them per command
+// before sendBLECommand(). A key's first change opens its flush window and the
+// whole window goes out as one notification, so a fast spin sends a few updates
+// rather than one per detent.
+enum OutboundPolicy {
+  SEND_IMMEDIATE,   // no coalescing
+  SEND_LATEST,      // the latest value wins
+  SEND_ACCUMULATE   // values add up
+};
+struct OutboundRule {
+  BleMessageType command;
+  OutboundPolicy policy;
+  uint16_t windowMs;
+};
+const OutboundRule OUTBOUND_RULES[] = {
+  { MSG_MUSIC_PLAY, SEND_IMMEDIATE, 0 },
+  { MSG_MUSIC_PAUSE, SEND_IMMEDIATE, 0 },
+  { MSG_MUSIC_NEXT, SEND_ACCUMULATE, 300 },  // net skip count, MSG_MUSIC_PREV adds -1
+  { MSG_MUSIC_VOLUME, SEND_LATEST, 150 },
+  { MSG_MUSIC_SEEK_RELATIVE, SEND_ACCUMULATE, 500 },
+  { MSG_EVENT_COMPLETE, SEND_IMMEDIATE, 0 }
+};
+#define OUTBOUND_KEYS (sizeof(OUTBOUND_RULES) / sizeof(OUTBOUND_RULES[0]))
+struct OutboundSlot {
+  bool pending;
+  long value;
+  unsigned long flushAt;
+};
+OutboundSlot outboundSlots[OUTBOUND_KEYS];
+
+// Notifications not yet confirmed by the TX status callback. Coalesced keys wait
+// while the cap is reached; a count that stops moving is assumed lost.
+#define BLE_TX_MAX_IN_FLIGHT 4
+const unsigned long BLE_TX_STALL_MS = 1000;
+const unsigned long BLE_TX_RETRY_MS = 20;
+std::atomic<uint8_t> bleTxInFlight(0);
+volatile unsigned long lastBleTxProgress = 0;
+
+// === Protocol Parsing ===
+// Walks one received message in place, splitting on a separator without copying.
+class FieldReader {
+public:
+  FieldReader(const char* data, size_t length, char separator = '|')
+    : pos(data), end(data + length), separator(separator) {}
+
+  // Next field as a view into the message; false once the message is used up
+  bool next(const char*& field, size_t& length) {
+    if (done) return false;
+    const char* sep = (const char*)memchr(pos, separator, end - pos);
+    field = pos;
+    if (sep) {
+      length = sep - pos;
+      pos = sep + 1;
+    } else {
+      length = end - pos;
+      pos = end;
+      done = true;
+    }
+    return true;
+  }
+
+  // Everything left, separators included (for trailing free-text fields)
+  bool rest(const char*& field, size_t& length) {
+    if (done) return false;
+    field = pos;
+    length = end - pos;
+    pos = end;
+    done = true;
+    return true;
+  }
+
+  bool nextLong(long& value) {
+    const char* field;
+    size_t length;
+    if (!next(field, length)) return false;
+    value = parseLong(field, length);
+    return true;
+  }
+
+  // Leading optional '-' and digits, stops at the first other character (like String::toInt)
+  static long parseLong(const char* text, size_t length) {
+    size_t i = 0;
+    bool negative = length > 0 && text[0] == '-';
+    if (negative) i++;
+    long value = 0;
+    for (; i < length && text[i] >= '0' && text[i] <= '9'; i++) {
+      value = value * 10 + (text[i] - '0');
+    }
+    return negative ? -value : value;
+  }
+
+  // Copy into a fixed buffer, truncating on a UTF-8 character boundary
+  static void copyText(char* dest, size_t capacity, const char* text, size_t length) {
+    if (length >= capacity) {
+      length = capacity - 1;
+      while (length > 0 && ((uint8_t)text[length] & 0xC0) == 0x80) length--;
+    }
+    memcpy(dest, text, length);
+    dest[length] = '\0';
+  }
+
+  static bool equals(const char* text, size_t length, const char* literal) {
+    return strlen(literal) == length && memcmp(text, literal, length) == 0;
+  }
+
+private:
+  const char* pos;
+  const char* end;
+  char separator;
+  bool done = false;
+};
 
 // === Eyes ===
 int COLOR_WHITE = 1;
 int COLOR_BLACK = 0;
 
+// === Eye Expressions ===
+// Expressions are keyframe sequences over the eye shape, advanced by elapsed time
+// each frame instead of delay() loops.
+enum EyeMode {
+  EYE_MODE_NORMAL,
+  EYE_MODE_HAPPY,
+  EYE_MODE_SAD
+};
+
+struct EyeKeyframe {
+  uint16_t durationMs;  // time to tween from the previous shape to this one
+  int8_t dw, dh;        // size offset from the default eye
+  int8_t corner;        // corner radius, -1 = default
+  uint8_t mode;         // EyeMode drawn while this keyframe plays
+};
+
+struct EyeExpression {
+  const EyeKeyframe* frames;
+  uint8_t count;
+};
+
+const EyeKeyframe BLINK_FRAMES[] = {
+  { 90, 0, -30, -1, EYE_MODE_NORMAL },
+  { 90, 0, 0, -1, EYE_MODE_NORMAL }
+};
+const EyeKeyframe WAKEUP_FRAMES[] = {
+  { 0, 0, -44, 0, EYE_MODE_NORMAL },
+  { 150, 0, 0, -1, EYE_MODE_NORMAL }
+};
+const EyeKeyframe EXCITED_FRAMES[] = {
+  { 60, 6, 6, -1, EYE_MODE_NORMAL }, { 60, 0, 0, -1, EYE_MODE_NORMAL },
+  { 60, 6, 6, -1, EYE_MODE_NORMAL }, { 60, 0, 0, -1, EYE_MODE_NORMAL },
+  { 60, 6, 6, -1, EYE_MODE_NORMAL }, { 60, 0, 0, -1, EYE_MODE_NORMAL }
+};
+const EyeKeyframe HAPPY_FRAMES[] = {
+  { 2000, 0, 0, -1, EYE_MODE_HAPPY }
+};
+const EyeKeyframe SAD_FRAMES[] = {
+  { 1000, 0, 0, -1, EYE_MODE_SAD }
+};
+
+const EyeExpression EXPR_BLINK   = { BLINK_FRAMES, 2 };
+const EyeExpression EXPR_WAKEUP  = { WAKEUP_FRAMES, 2 };
+const EyeExpression EXPR_EXCITED = { EXCITED_FRAMES, 6 };
+const EyeExpression EXPR_HAPPY   = { HAPPY_FRAMES, 1 };
+const EyeExpression EXPR_SAD     = { SAD_FRAMES, 1 };
+
+const unsigned long EYE_FRAME_INTERVAL = 16;  // redraw period while an expression plays
+const int EYE_QUEUE_SIZE = 4;
+
+// === Eye Shape Cache ===
+// Eye shapes are rasterized once into column masks (bit n = row n of the shape)
+// and blitted into the page-major frame buffer with a shift and OR per column.
+// Both eyes share a shape, so the idle face is one cache hit per frame.
+enum EyeShapeKind : uint8_t {
+  EYE_SHAPE_RBOX,  // rounded box
+  EYE_SHAPE_ARCH,  // top half of a disc (happy eyes)
+  EYE_SHAPE_LID    // triangle from the top centre to the middle row (sad lids)
+};
+
+#define EYE_MASK_MAX_W 64
+#define EYE_CACHE_SIZE 4
+
+struct EyeMask {
+  uint8_t kind, w, h, corner;
+  uint32_t lastUsed;  // 0 = empty slot
+  uint64_t cols[EYE_MASK_MAX_W];
+};
+
+class EyeMaskCache {
+public:
+  // Cached mask for the shape, rasterizing into the least recently used slot on a miss
+  const EyeMask& get(uint8_t kind, int w, int h, int corner) {
+    w = constrain(w, 1, EYE_MASK_MAX_W);
+    h = constrain(h, 1, 64);
+    if (kind == EYE_SHAPE_RBOX) {
+      // Same clamp drawRBox needs: the corners must fit the box
+      if (w < 2 * (corner + 1)) corner = w / 2 - 1;
+      if (h < 2 * (corner + 1)) corner = h / 2 - 1;
+      if (corner < 0) corner = 0;
+    } else {
+      corner = 0;
+    }
+
+    tick++;
+    EyeMask* victim = &slots[0];
+    for (EyeMask& m : slots) {
+      if (m.lastUsed && m.kind == kind && m.w == w && m.h == h && m.corner == corner) {
+        m.lastUsed = tick;
+        return m;
+      }
+      if (m.lastUsed < victim->lastUsed) victim = &m;
+    }
+
+    victim->kind = kind;
+    victim->w = w;
+    victim->h = h;
+    victim->corner = corner;
+    victim->lastUsed = tick;
+    rasterize(*victim);
+    return *victim;
+  }
+
+  // OR (or clear, when erase is set) the mask into the frame buffer with its top-left at x, y
+  void blit(const EyeMask& m, int x, int y, bool erase) {
+    if (y <= -64 || y >= 64) return;
+    uint8_t* buf = u8g2.getBufferPtr();
+    int bufWidth = u8g2.getBufferTileWidth() * 8;
+    int pages = u8g2.getBufferTileHeight();
+
+    for (int c = 0; c < m.w; c++) {
+      int px = x + c;
+      if (px < 0 || px >= bufWidth) continue;
+      uint64_t bits = y >= 0 ? m.cols[c] << y : m.cols[c] >> -y;
+      for (int page = 0; page < pages && bits; page++, bits >>= 8) {
+        uint8_t b = bits;
+        if (!b) continue;
+        if (erase) buf[page * bufWidth + px] &= ~b;
+        else buf[page * bufWidth + px] |= b;
+      }
+    }
+  }
+
+private:
+  EyeMask slots[EYE_CACHE_SIZE] = {};
+  uint32_t tick = 0;
+
+  static uint64_t rows(int from, int to) {
+    if (to <= from) return 0;
+    uint64_t upper = to >= 64 ? ~0ULL : (1ULL << to) - 1;
+    return upper & ~((1ULL << from) - 1);
+  }
+
+  static void rasterize(EyeMask& m) {
+    for (int c = 0; c < m.w; c++) {
+      switch (m.kind) {
+        case EYE_SHAPE_RBOX: {
+          // Corners inset each end of the column by the same amount
+          int inset = 0;
+          int r = m.corner;
+          int edge = min(c, m.w - 1 - c);
+          if (edge < r) {
+            float dx = r - edge - 0.5f;
+            inset = r - (int)(sqrtf(r * r - dx * dx) + 0.5f);
+          }
+          m.cols[c] = rows(inset, m.h - inset);
+          break;
+        }
+        case EYE_SHAPE_ARCH: {
+          // w = 2h + 1, the disc centre sits one row below the mask
+          int dx = c - m.h;
+          int height = (int)(sqrtf(m.h * m.h - dx * dx) + 0.5f);
+          m.cols[c] = rows(m.h - height, m.h);
+          break;
+        }
+        case EYE_SHAPE_LID: {
+          float half = m.w / 2.0f;
+          int top = (int)((m.h - 1) * fabsf(c + 0.5f - half) / half + 0.5f);
+          m.cols[c] = rows(top, m.h);
+          break;
+        }
+      }
+    }
+  }
+};
+
+EyeMaskCache eyeMasks;
+
 class EyeManager {
 public:
   struct EyeState {
@@ -228,35 +938,16 @@ public:
   }
 
   void display_display() {
-    u8g2.sendBuffer();
+    flushDisplay();
   }
   void display_clearDisplay() {
     u8g2.clearBuffer();
   }
 
-  void display_fillRoundRect(int x, int y, int w, int h, int r, int color) {
-    u8g2.setDrawColor(color);
-    if (w < 2 * (r + 1)) {
-      r = (w / 2) - 1;
-    }
-    if (h < 2 * (r + 1)) {
-      r = (h / 2) - 1;
-    }
-    u8g2.drawRBox(x, y, w < 1 ? 1 : w, h < 1 ? 1 : h, r);
-  }
-
-  void display_fillTriangle(int x0, int y0, int x1, int y1, int x2, int y2, int color) {
-    u8g2.setDrawColor(color);
-    u8g2.drawTriangle(x0, y0, x1, y1, x2, y2);
-  }
-
   void reset() {
-    left.w = right.w = defaultW;
-    left.h = right.h = defaultH;
-    left.corner = right.corner = defaultCorner;
-    left.x = SCREEN_WIDTH / 2.0f - left.w / 2.0f - spacing / 2.0f;
-    right.x = SCREEN_WIDTH / 2.0f + right.w / 2.0f + spacing / 2.0f;
-    left.y = right.y = SCREEN_HEIGHT / 2.0f;
+    stop();
+    setShape(defaultW, defaultH, defaultCorner);
+    centre();
     draw();
   }
 
@@ -274,46 +965,148 @@ public:
 
   void draw(bool update = true) {
     display_clearDisplay();
-    drawEye(left);
-    drawEye(right);
+    if (mode == EYE_MODE_HAPPY) {
+      drawHappy();
+    } else {
+      drawEye(left);
+      drawEye(right);
+      if (mode == EYE_MODE_SAD) drawSadLids();
+    }
     if (update) display_display();
   }
 
-  void blink() {
-    float originalH = left.h;
-    for (int i = 0; i < 3; i++) {
-      left.h -= 10;
-      right.h -= 10;
-      draw();
-      delay(30);
-    }
-    for (int i = 0; i < 3; i++) {
-      left.h += 10;
-      right.h += 10;
-      draw();
-      delay(30);
+  // Queue an expression; interrupt = drop whatever is playing or queued
+  void play(const EyeExpression& expr, bool interrupt = false) {
+    if (interrupt) stop();
+    if (queueCount == EYE_QUEUE_SIZE) return;
+    queue[(queueHead + queueCount) % EYE_QUEUE_SIZE] = &expr;
+    queueCount++;
+  }
+
+  void stop() {
+    active = nullptr;
+    queueCount = 0;
+    mode = EYE_MODE_NORMAL;
+  }
+
+  bool isAnimating() {
+    return active != nullptr || queueCount > 0;
+  }
+
+  // Drop any expression and snap back to the resting shape without drawing
+  void cancel() {
+    if (!isAnimating()) return;
+    stop();
+    setShape(defaultW, defaultH, defaultCorner);
+  }
+
+  // Advance the playing expression to 'now'; returns true while one is playing
+  bool update(unsigned long now) {
+    if (!active && !startNext(now)) return false;
+
+    while (active) {
+      const EyeKeyframe& kf = active->frames[frameIndex];
+      unsigned long elapsed = now - frameStart;
+      if (elapsed < kf.durationMs) {
+        applyKeyframe(kf, elapsed / (float)kf.durationMs);
+        return true;
+      }
+
+      // Keyframe done: land on it exactly and carry the overshoot into the next one
+      applyKeyframe(kf, 1.0f);
+      frameStart += kf.durationMs;
+      if (++frameIndex < active->count) {
+        captureFrom();
+      } else {
+        active = nullptr;
+        mode = EYE_MODE_NORMAL;
+        if (!startNext(now)) return false;
+      }
     }
+    return false;
+  }
+
+  void blink() {
+    play(EXPR_BLINK);
   }
 
+  // Closed eyes, drawn but not flushed so the caller can add to the frame
   void sleep() {
-    reset();
-    left.h = right.h = 2;
-    left.corner = right.corner = 0;
-    draw();
+    stop();
+    setShape(defaultW, 2, 0);
+    centre();
+    draw(false);
   }
 
   void wakeup() {
-    for (int h = 2; h <= defaultH; h += 4) {
-      left.h = right.h = h;
-      left.corner = right.corner = min(h, defaultCorner);
-      draw();
-      delay(10);
-    }
+    play(EXPR_WAKEUP, true);
   }
 
   void happy() {
-    reset();
+    play(EXPR_HAPPY, true);
+  }
+
+  void sad() {
+    play(EXPR_SAD, true);
+  }
 
+  void excited() {
+    play(EXPR_EXCITED, true);
+  }
+
+private:
+  const EyeExpression* queue[EYE_QUEUE_SIZE];
+  int queueHead = 0, queueCount = 0;
+  const EyeExpression* active = nullptr;
+  int frameIndex = 0;
+  unsigned long frameStart = 0;
+  float fromW = 0, fromH = 0;
+  int fromCorner = 0;
+  uint8_t mode = EYE_MODE_NORMAL;
+
+  bool startNext(unsigned long now) {
+    if (queueCount == 0) return false;
+    active = queue[queueHead];
+    queueHead = (queueHead + 1) % EYE_QUEUE_SIZE;
+    queueCount--;
+    frameIndex = 0;
+    frameStart = now;
+    captureFrom();
+    return true;
+  }
+
+  void captureFrom() {
+    fromW = left.w;
+    fromH = left.h;
+    fromCorner = left.corner;
+    mode = active->frames[frameIndex].mode;
+  }
+
+  void applyKeyframe(const EyeKeyframe& kf, float t) {
+    float toW = defaultW + kf.dw;
+    float toH = defaultH + kf.dh;
+    int toCorner = kf.corner < 0 ? defaultCorner : kf.corner;
+    setShape(fromW + (toW - fromW) * t, fromH + (toH - fromH) * t, fromCorner + (int)((toCorner - fromCorner) * t));
+  }
+
+  void centre() {
+    left.x = SCREEN_WIDTH / 2.0f - left.w / 2.0f - spacing / 2.0f;
+    right.x = SCREEN_WIDTH / 2.0f + right.w / 2.0f + spacing / 2.0f;
+    left.y = right.y = SCREEN_HEIGHT / 2.0f;
+  }
+
+  void setShape(float w, float h, int corner) {
+    left.w = right.w = w;
+    left.h = right.h = h;
+    left.corner = right.corner = corner;
+  }
+
+  void drawEye(EyeState& eye) {
+    const EyeMask& mask = eyeMasks.get(EYE_SHAPE_RBOX, eye.w, eye.h, eye.corner);
+    eyeMasks.blit(mask, eye.x - eye.w / 2, eye.y - eye.h / 2, false);
+  }
+
+  void drawHappy() {
     int eyeW = defaultW * 0.7;   // narrower eyes
     int eyeH = defaultH * 0.6;   // shorter eyes
     int radius = eyeW / 2;
@@ -322,21 +1115,11 @@ public:
     int leftX = SCREEN_WIDTH / 2 - eyeW - spacing / 2;
     int rightX = SCREEN_WIDTH / 2 + spacing / 2;
 
-    // --- Eyes with rounded top (fake half-circle using drawDisc) ---
-    // Left
-    display_fillRoundRect(leftX, eyeY + eyeH / 3, eyeW, eyeH * 2 / 3, 0, 1);
-    u8g2.setDrawColor(1);
-    u8g2.drawDisc(leftX + eyeW / 2, eyeY + eyeH / 3, radius);
-    // Mask bottom half (erase it)
-    u8g2.setDrawColor(0);
-    u8g2.drawBox(leftX, eyeY + eyeH / 3, eyeW, eyeH * 2 / 3);
-    u8g2.setDrawColor(1);
-
-    // Right
-    display_fillRoundRect(rightX, eyeY + eyeH / 3, eyeW, eyeH * 2 / 3, 0, 1);
-    u8g2.drawDisc(rightX + eyeW / 2, eyeY + eyeH / 3, radius);
-    u8g2.setDrawColor(0);
-    u8g2.drawBox(rightX, eyeY + eyeH / 3, eyeW, eyeH * 2 / 3);
+    // --- Eyes: top half of a disc resting on eyeY + eyeH / 3 ---
+    const EyeMask& arch = eyeMasks.get(EYE_SHAPE_ARCH, 2 * radius + 1, radius, 0);
+    int archY = eyeY + eyeH / 3 - radius;
+    eyeMasks.blit(arch, leftX + eyeW / 2 - radius, archY, false);
+    eyeMasks.blit(arch, rightX + eyeW / 2 - radius, archY, false);
     u8g2.setDrawColor(1);
 
     // --- Smile arc ---
@@ -344,68 +1127,23 @@ public:
     int smileY = SCREEN_HEIGHT / 2 + eyeH;
     int smileR = 12;
     u8g2.drawArc(smileX, smileY, smileR, 200, 340); // valid call: x,y,r,start,end
-
-    display_display();
-  }
-
-  void sad() {
-    reset();
-    display_fillTriangle(left.x - left.w / 2, left.y, left.x + left.w / 2, left.y, left.x, left.y - left.h / 2, COLOR_BLACK);
-    display_fillTriangle(right.x - right.w / 2, right.y, right.x + right.w / 2, right.y, right.x, right.y - right.h / 2, COLOR_BLACK);
-    display_display();
-  }
-
-  void excited() {
-    reset();
-    for (int i = 0; i < 3; i++) {
-      left.w += 6;
-      right.w += 6;
-      left.h += 6;
-      right.h += 6;
-      draw();
-      delay(60);
-      left.w -= 6;
-      right.w -= 6;
-      left.h -= 6;
-      right.h -= 6;
-      draw();
-      delay(60);
-    }
   }
 
-private:
-  void drawEye(EyeState& eye) {
-    display_fillRoundRect(eye.x - eye.w / 2, eye.y - eye.h / 2, eye.w, eye.h, eye.corner, COLOR_WHITE);
+  // Erase a triangle from each eye's top centre down to its middle row
+  void drawSadLids() {
+    const EyeMask& lid = eyeMasks.get(EYE_SHAPE_LID, left.w, left.h / 2 + 1, 0);
+    eyeMasks.blit(lid, left.x - left.w / 2, left.y - left.h / 2, true);
+    eyeMasks.blit(lid, right.x - right.w / 2, right.y - right.h / 2, true);
   }
 };
 
 EyeManager eyes(46, 46, 12, 10); // width, height, spacing, corner
 
-// Threshold for detecting pickup movement
-float pickupThreshold = 1.2;
-
-void checkPickup() {
-  sensors_event_t event;
-  adxl.getEvent(&event);
-
-  // Calculate magnitude of acceleration vector (ignoring gravity offset ~9.8)
-  float ax = event.acceleration.x / 9.8;
-  float ay = event.acceleration.y / 9.8;
-  float az = event.acceleration.z / 9.8;
-
-  float magnitude = sqrt(ax * ax + ay * ay + az * az);
-
-  if (magnitude > pickupThreshold) {
-    eyes.happy();
-    delay(1500);
-    eyes.reset();
-  }
-}
-
 void setup() {
   Serial.begin(115200);
   u8g2.begin();
   u8g2.setContrast(255);  // Full brightness initially
+  startDisplayTask();
 
   eyes.reset();
 
@@ -414,6 +1152,8 @@ void setup() {
 
   pinMode(ENCODER1_BTN, INPUT_PULLUP);
   pinMode(ENCODER2_BTN, INPUT_PULLUP);
+  attachInterrupt(digitalPinToInterrupt(ENCODER1_BTN), encoder1ButtonISR, CHANGE);
+  attachInterrupt(digitalPinToInterrupt(ENCODER2_BTN), encoder2ButtonISR, CHANGE);
   pinMode(PIR_PIN, INPUT);
   pinMode(BUZZER_PIN, OUTPUT);
 
@@ -424,122 +1164,241 @@ void setup() {
   encoder1.attachFullQuad(ENCODER1_A, ENCODER1_B);
   encoder1.setCount(0);
 
+  // Rotation is counted by PCNT; these edges only end a frame-pacing wait
+  wakeSignal = xSemaphoreCreateBinary();
+  attachInterrupt(digitalPinToInterrupt(ENCODER1_A), wakeLoopFromISR, CHANGE);
+  attachInterrupt(digitalPinToInterrupt(ENCODER2_A), wakeLoopFromISR, CHANGE);
+  userPresent = digitalRead(PIR_PIN);
+  attachInterrupt(digitalPinToInterrupt(PIR_PIN), pirISR, CHANGE);
+  if (accelReady) {
+    pinMode(ADXL_INT_PIN, INPUT);
+    attachInterrupt(digitalPinToInterrupt(ADXL_INT_PIN), accelActivityISR, RISING);
+    // Activity latched since setupSensors() cleared INT_SOURCE holds INT1 high and
+    // would never give another edge; hand it to handleWakeSources() to release
+    if (digitalRead(ADXL_INT_PIN)) accelActivity = true;
+  }
+
   lastMotionTime = millis();
+
+  // Periodic background work
+  scheduleTask(updateClock, 0, 0);
+  scheduleTask(updateAmbientLight, 0, LDR_INTERVAL);
+  scheduleTask(blinkEyes, eyeAnimInterval, eyeAnimInterval);
+  if (accelReady) scheduleTask(sampleTilt, accelReadInterval, accelReadInterval);
+#if ENABLE_PROFILER
+  scheduleTask(reportStatsToBle, STATS_REPORT_INTERVAL, STATS_REPORT_INTERVAL);
+#endif
   
   // Initialize Pong game
   initializePongGame();
 }
 
 void setupSensors() {
-  dht.begin();
+  pinMode(DHT_PIN, INPUT_PULLUP);
 
   if (!adxl.begin()) {
     Serial.println("ADXL345 initialization failed");
   } else {
     adxl.setRange(ADXL345_RANGE_2_G);
+    adxl.setDataRate(ADXL345_DATARATE_25_HZ);
+    adxl.writeRegister(ADXL345_REG_FIFO_CTL, ADXL_FIFO_STREAM);
+
+    // Movement on any axis latches INT1 until INT_SOURCE is read
+    adxl.writeRegister(ADXL345_REG_THRESH_ACT, ADXL_ACTIVITY_THRESHOLD);
+    adxl.writeRegister(ADXL345_REG_ACT_INACT_CTL, ADXL_ACT_AC_XYZ);
+    adxl.writeRegister(ADXL345_REG_INT_MAP, 0x00);
+    adxl.writeRegister(ADXL345_REG_INT_ENABLE, ADXL_INT_ACTIVITY);
+    adxl.readRegister(ADXL345_REG_INT_SOURCE);
+    accelReady = true;
     Serial.println("ADXL345 initialized at I2C address 0x53");
   }
+
+  // Reads sleep while the pin interrupt captures the reply, so nothing blocks
+  // either core; the edge ISR runs on core 1, clear of the BT controller
+  xTaskCreatePinnedToCore(dhtTask, "dht", 2048, nullptr, 1, nullptr, 1);
+}
+
+void IRAM_ATTR dhtEdgeISR() {
+  uint8_t i = dhtEdgeCount;
+  if (i < DHT_EDGES) {
+    dhtEdges[i] = micros();
+    dhtEdgeCount = i + 1;
+  }
+}
+
+// Start pulse, capture, decode. False when the sensor doesn't answer in full or
+// the checksum fails.
+bool readDht11(float& temperature, float& humidity) {
+  pinMode(DHT_PIN, OUTPUT);
+  digitalWrite(DHT_PIN, LOW);
+  vTaskDelay(pdMS_TO_TICKS(DHT_START_MS));
+
+  dhtEdgeCount = 0;
+  attachInterrupt(digitalPinToInterrupt(DHT_PIN), dhtEdgeISR, FALLING);
+  pinMode(DHT_PIN, INPUT_PULLUP);  // release the line; the sensor answers within 40 us
+  vTaskDelay(pdMS_TO_TICKS(DHT_FRAME_MS));
+  detachInterrupt(digitalPinToInterrupt(DHT_PIN));
+  if (dhtEdgeCount < DHT_EDGES) return false;
+
+  uint8_t data[5] = {};
+  for (uint8_t bit = 0; bit < 40; bit++) {
+    uint32_t period = dhtEdges[bit + 2] - dhtEdges[bit + 1];
+    data[bit / 8] = (data[bit / 8] << 1) | (period > DHT_ONE_US);
+  }
+  if ((uint8_t)(data[0] + data[1] + data[2] + data[3]) != data[4]) return false;
+
+  humidity = data[0] + data[1] * 0.1f;
+  temperature = data[2] + (data[3] & 0x0F) * 0.1f;
+  if (data[3] & 0x80) temperature = -temperature;
+  return true;
+}
+
+void dhtTask(void* param) {
+  TickType_t lastWake = xTaskGetTickCount();
+  for (;;) {
+    float newTemperature, newHumidity;
+    if (readDht11(newTemperature, newHumidity)) {
+      portENTER_CRITICAL(&dhtMux);
+      dhtTemperature = newTemperature;
+      dhtHumidity = newHumidity;
+      dhtSampleCount++;
+      portEXIT_CRITICAL(&dhtMux);
+    }
+    vTaskDelayUntil(&lastWake, pdMS_TO_TICKS(tempReadInterval));
+  }
 }
 
 void loop() {
-  checkEncoders();
-  updateClock();
-  handleState();
+  unsigned long passStart = millis();
+  PROFILE(PHASE_LOOP, runLoopPass());
+  paceFrame(passStart);
+}
+
+void runLoopPass() {
+  PROFILE(PHASE_BLE, handleConnectionFeedback(); processBleMessages());
+  handleWakeSources();
+  PROFILE(PHASE_INPUT, checkEncoders());
+  PROFILE(PHASE_TASKS, runDueTasks(millis()));
+  PROFILE(PHASE_STATE, handleState());
+  handleSerialCommands();
 
   if (currentState != SLEEP) {
-    // checkPickup();
-    readSensors();
+    PROFILE(PHASE_SENSORS, readSensors());
     handleSleepMode();
-    handleOverlays();
-    updateSeek(); // listen for seek input
+    PROFILE(PHASE_SEEK, updateSeek());
   }
+}
 
-  if (deviceConnected) {
-    static unsigned long lastSent = 0;
-    if (millis() - lastSent > 10000) {  // Every 10 seconds
-      sendStatusToBLE();
-      lastSent = millis();
+// Line commands typed into the Serial monitor
+void handleSerialCommands() {
+  static char line[16];
+  static uint8_t length = 0;
+
+  while (Serial.available()) {
+    char c = Serial.read();
+    if (c == '\r' || c == '\n') {
+      line[length] = '\0';
+      if (strcmp(line, "STATS") == 0) reportStats(false);
+      length = 0;
+    } else if (length < sizeof(line) - 1) {
+      line[length++] = c;
     }
   }
 }
 
 void checkEncoders() {
-  // Read button states
-  bool btn1 = !digitalRead(ENCODER1_BTN);
-  bool btn2 = !digitalRead(ENCODER2_BTN);
-
-  // === Encoder 1 ===
-  if (btn1 && !encoder1BtnPressed) {
-    // Button just pressed
-    encoder1BtnStart = millis();
-    encoder1LongPress = false;
-  } else if (btn1 && encoder1BtnPressed && !encoder1LongPress) {
-    // Still holding -> check for long press
-    if (millis() - encoder1BtnStart >= LONG_PRESS_TIME) {
-      encoder1LongPress = true;  // Trigger once
+  pollEncoderRotation();
+
+  InputEvent event;
+  while (popInputEvent(event)) dispatchInputEvent(event);
+
+  for (uint8_t encoder = 0; encoder < 2; encoder++) {
+    ButtonState& button = buttons[encoder];
+    uint32_t now = millis();
+
+    // An edge swallowed by the debounce window leaves the state stale; settle on the pin level
+    bool level = !digitalRead(encoder == 0 ? ENCODER1_BTN : ENCODER2_BTN);
+    if (level != button.pressed && now - button.lastEdge >= BUTTON_DEBOUNCE) {
+      dispatchInputEvent({ encoder, level ? INPUT_PRESS : INPUT_RELEASE, 0, now });
     }
-  }
 
-  // === Encoder 2 ===
-  if (btn2 && !encoder2BtnPressed) {
-    encoder2BtnStart = millis();
-    encoder2LongPress = false;
-  } else if (btn2 && encoder2BtnPressed && !encoder2LongPress) {
-    if (millis() - encoder2BtnStart >= LONG_PRESS_TIME) {
-      encoder2LongPress = true;
+    // Long press fires once the hold passes LONG_PRESS_TIME, measured from the press edge
+    if (button.pressed && !button.longPressFired && now - button.pressTime >= LONG_PRESS_TIME) {
+      button.longPressFired = true;
+      fireEncoderLongPress(encoder);
     }
   }
-
-  // Update states
-  encoder1BtnPressed = btn1;
-  encoder2BtnPressed = btn2;
-
-  checkEncoder1();
-  checkEncoder2();
 }
 
 void readSensors() {
-  // PIR sensor
-  userPresent = digitalRead(PIR_PIN);
-  if (userPresent) {
-    lastMotionTime = millis();
-    if (isAsleep) wakeUp();
+  // Temperature and humidity, published by dhtTask
+  portENTER_CRITICAL(&dhtMux);
+  bool freshSample = dhtSampleCount != dhtSamplesSeen;
+  float newTemperature = dhtTemperature;
+  float newHumidity = dhtHumidity;
+  dhtSamplesSeen = dhtSampleCount;
+  portEXIT_CRITICAL(&dhtMux);
+
+  if (freshSample) {
+    if (newTemperature != temperature || newHumidity != humidity) invalidateRender(DEP_SENSORS);
+    temperature = newTemperature;
+    humidity = newHumidity;
   }
+}
 
-  // Temperature and humidity
-  if (millis() - lastTempRead > tempReadInterval) {
-    temperature = dht.readTemperature();
-    humidity = dht.readHumidity();
-    lastTempRead = millis();
+// Scheduled every accelReadInterval
+void sampleTilt() {
+  drainAccelFifo();
+  if (fabs(filteredTiltX - tiltX) > TILT_EPSILON || fabs(filteredTiltY - tiltY) > TILT_EPSILON) {
+    tiltX = filteredTiltX;
+    tiltY = filteredTiltY;
+    invalidateRender(DEP_TILT);
   }
+}
 
-  // Accelerometer
-  if (millis() - lastAccelRead > accelReadInterval) {
-    sensors_event_t event;
-    adxl.getEvent(&event);
-
-    tiltX = event.acceleration.x / 9.8;   // forward/back (Y is downward arrow → invert for chest mount)
-    tiltY = event.acceleration.z / 9.8;   // left/right tilt (X arrow is left)
+// Low-pass every sample the ADXL345 buffered since the last drain
+void drainAccelFifo() {
+  uint8_t queued = adxl.readRegister(ADXL345_REG_FIFO_STATUS) & ADXL_FIFO_ENTRIES_MASK;
+  for (uint8_t i = 0; i < queued; i++) {
+    int16_t x, y, z;
+    if (!readAccelSample(x, y, z)) break;
 
-    lastAccelRead = millis();
+    float sampleX = x * ADXL345_MG2G_MULTIPLIER;  // forward/back (Y is downward arrow → invert for chest mount)
+    float sampleY = z * ADXL345_MG2G_MULTIPLIER;  // left/right tilt (X arrow is left)
+    filteredTiltX += TILT_FILTER_ALPHA * (sampleX - filteredTiltX);
+    filteredTiltY += TILT_FILTER_ALPHA * (sampleY - filteredTiltY);
   }
 }
 
+// Pop one FIFO entry: all three axes in a single repeated-start read
+bool readAccelSample(int16_t& x, int16_t& y, int16_t& z) {
+  Wire.beginTransmission(ADXL345_DEFAULT_ADDRESS);
+  Wire.write(ADXL345_REG_DATAX0);
+  if (Wire.endTransmission(false) != 0) return false;
+  if (Wire.requestFrom((uint8_t)ADXL345_DEFAULT_ADDRESS, (uint8_t)6) != 6) return false;
+
+  uint8_t data[6];
+  for (int i = 0; i < 6; i++) data[i] = Wire.read();
+  x = (int16_t)(data[1] << 8 | data[0]);
+  y = (int16_t)(data[3] << 8 | data[2]);
+  z = (int16_t)(data[5] << 8 | data[4]);
+  return true;
+}
+
+// Scheduled on each wall-clock minute so faces showing the time redraw
 void updateClock() {
-  // Tick every second
-  if (millis() - lastTick >= 1000) {
-    lastTick += 1000;
-    currentSecond++;
-    if (currentSecond >= 60) {
-      currentSecond = 0;
-      currentMinute++;
-      if (currentMinute >= 60) {
-        currentMinute = 0;
-        currentHour++;
-        if (currentHour >= 24) currentHour = 0;
-      }
-    }
-  }
+  invalidateRender(DEP_CLOCK);
+  scheduleTask(updateClock, 60000 - clockMillisOfDay() % 60000, 0);
+}
+
+// Unwrapped ms of day: the anchor plus drift-corrected time since it
+int64_t clockProject(int64_t fromUs, int64_t fromMs, int64_t nowUs) {
+  int64_t elapsedMs = (nowUs - fromUs) / 1000;
+  return fromMs + elapsedMs + (int64_t)(elapsedMs * (double)clockDriftPpm / 1e6);
+}
+
+long clockMillisOfDay() {
+  return (long)(clockProject(clockAnchorUs, clockAnchorMs, esp_timer_get_time()) % MS_PER_DAY);
 }
 
 void handleSleepMode() {
@@ -548,27 +1407,33 @@ void handleSleepMode() {
   }
 }
 
+// Draws the sleep frame once; loop() then idles until a wake source fires
 void goToSleep() {
   isAsleep = true;
-  u8g2.setContrast(25);  // Dim the display
+  setDisplayContrast(25);  // Dim the display
   eyes.sleep();
+  drawPackedSprite(SCREEN_WIDTH - 26, 4, sleepFace, 0);
+  flushDisplay();
   Serial.println("Going to sleep mode");
-  u8g2.drawXBMP(SCREEN_WIDTH - 26, 4, 24, 24, sleepFace);
 }
 
 void wakeUp() {
   isAsleep = false;
-  u8g2.setContrast(255);  // Full brightness
+  if (currentState == SLEEP) {
+    previousState = SLEEP;
+    currentState = IDLE;
+  }
+  setDisplayContrast(ambientContrast);  // Back to the ambient brightness
   eyes.wakeup();
+  invalidateRender(DEP_ALL);
   Serial.println("Waking up");
 }
 
-void handleOverlays() {
-  // Notification popup timeout
-  if (showNotificationPopup && millis() - notificationPopupStart > NOTIFICATION_POPUP_DURATION) {
-    showNotificationPopup = false;
-    currentState = previousState;
-  }
+// Scheduled NOTIFICATION_POPUP_DURATION after the popup opens
+void closeNotificationPopup() {
+  if (!showNotificationPopup) return;
+  showNotificationPopup = false;
+  currentState = previousState;
 }
 
 void handleState() {
@@ -576,6 +1441,82 @@ void handleState() {
     return;  // Don't update display when asleep except for overlays
   }
 
+  updateStateLogic();
+
+  if (renderExpression()) return;
+  if (!renderDue()) return;
+
+  renderDirty = 0;
+  renderDeadlineSet = false;
+  lastRenderedState = currentState;
+  PROFILE(PHASE_FACE + currentState, renderState());
+}
+
+// Per-state work that must run every pass, independent of redraws
+void updateStateLogic() {
+  if (currentState == TIMER) {
+    if (timerState == TIMER_RUNNING || timerState == TIMER_PAUSED) updateTimer();
+  }
+}
+
+// Expressions play over whatever face is active; the face redraws once they finish
+bool renderExpression() {
+  static bool expressionShown = false;
+  static unsigned long lastExpressionFrame = 0;
+  unsigned long now = millis();
+
+  if (eyes.update(now)) {
+    if (!expressionShown || now - lastExpressionFrame >= EYE_FRAME_INTERVAL) {
+      eyes.draw();
+      lastExpressionFrame = now;
+    }
+    expressionShown = true;
+    return true;
+  }
+
+  if (expressionShown) {
+    expressionShown = false;
+    invalidateRender(DEP_ALL);
+  }
+  return false;
+}
+
+uint16_t faceDependencies(AppState state) {
+  switch (state) {
+    case IDLE:               return DEP_INPUT | DEP_TILT;
+    case CLOCK:              return DEP_INPUT | DEP_CLOCK | DEP_SENSORS;
+    case MUSIC:              return DEP_INPUT | DEP_MUSIC;
+    case NOTIFICATIONS:      return DEP_INPUT | DEP_NOTIFICATIONS;
+    case TIMER:              return DEP_INPUT | DEP_TIMER;
+    case EVENTS:             return DEP_INPUT | DEP_EVENTS;
+    case NOTIFICATION_POPUP: return DEP_INPUT | DEP_NOTIFICATIONS;
+    default:                 return DEP_INPUT;
+  }
+}
+
+bool renderDue() {
+  if (currentState != lastRenderedState) return true;
+  if (renderDirty & faceDependencies(currentState)) return true;
+  return renderDeadlineSet && (long)(millis() - renderDeadline) >= 0;
+}
+
+void invalidateRender(uint16_t deps) {
+  renderDirty |= deps;
+}
+
+// Faces call these while rendering to request their next redraw
+void scheduleRenderAt(unsigned long when) {
+  if (!renderDeadlineSet || (long)(when - renderDeadline) < 0) {
+    renderDeadline = when;
+    renderDeadlineSet = true;
+  }
+}
+
+void scheduleRenderIn(unsigned long ms) {
+  scheduleRenderAt(millis() + ms);
+}
+
+void renderState() {
   switch (currentState) {
     case IDLE:
       handleIdleState();
@@ -610,17 +1551,16 @@ void handleState() {
   }
 }
 
+// Scheduled every eyeAnimInterval; only the idle face has eyes to blink
+void blinkEyes() {
+  if (currentState == IDLE && !isAsleep) eyes.blink();
+}
+
 void handleIdleState() {
   // Apply tilt to eyes for fluid animation
   eyes.applyTilt(tiltX + lookOffsetX, tiltY + lookOffsetY);
   eyes.draw();
 
-  // Periodic blinking
-  if (millis() - lastEyeAnim > eyeAnimInterval) {
-    eyes.blink();
-    lastEyeAnim = millis();
-  }
-
   // Random look-around
   // if (millis() - lastLookAround > lookAroundInterval) {
   //   lookOffsetX = random(-40, 41) / 10.0f;  // -2.0 to +2.0
@@ -634,6 +1574,10 @@ void handleIdleState() {
 void displayClockFace() {
   u8g2.clearBuffer();
 
+  long now = clockMillisOfDay();
+  int currentHour = now / 3600000;
+  int currentMinute = now / 60000 % 60;
+
   int displayHour = currentHour % 12;
   if (displayHour == 0) displayHour = 12;
   bool isPM = (currentHour >= 12);
@@ -665,7 +1609,10 @@ void displayClockFace() {
   int infoWidth = u8g2.getStrWidth(infoStr);
   u8g2.drawStr((128 - infoWidth) / 2, 60, infoStr);
 
-  u8g2.sendBuffer();
+  flushDisplay();
+
+  // Colon blinks on 500ms boundaries
+  scheduleRenderAt((millis() / 500 + 1) * 500);
 }
 
 // tiny volume icons (8×8)
@@ -697,9 +1644,70 @@ static void drawMaxIcon(int x, int y) { // speaker + waves
 int scrollOffset = 0;
 unsigned long lastPlaybackUpdate = 0;
 
-// ---- main render ----
-void displayMusicFace() {
-  u8g2.clearBuffer();
+// Fit text into maxWidth, cutting on a UTF-8 boundary and appending ".."
+void ellipsizeText(char* out, size_t outSize, const char* text, int maxWidth) {
+  FieldReader::copyText(out, outSize - 2, text, strlen(text));
+  if (u8g2.getUTF8Width(out) <= maxWidth) return;
+
+  size_t length = strlen(out);
+  while (length > 0) {
+    do { length--; } while (length > 0 && ((uint8_t)out[length] & 0xC0) == 0x80);
+    memcpy(out + length, "..", 3);
+    if (u8g2.getUTF8Width(out) <= maxWidth) return;
+  }
+}
+
+// Measure and ellipsize once per track, and rasterize a long title into
+// marqueeStrip by rendering it 128 px at a time into the frame buffer
+void layoutMusicText(int maxWidth) {
+  u8g2.setFont(u8g2_font_6x12_tf);
+  ellipsizeText(musicAlbumLine, sizeof(musicAlbumLine), currentAlbum, maxWidth);
+  ellipsizeText(musicArtistLine, sizeof(musicArtistLine), currentArtist, maxWidth);
+
+  u8g2.setFont(u8g2_font_ncenB10_tf);
+  musicSongWidth = u8g2.getUTF8Width(currentSong);
+  marqueePeriod = 0;
+  scrollOffset = 0;
+  musicLayoutValid = true;
+  if (musicSongWidth <= maxWidth) return;
+
+  int stripWidth = min(musicSongWidth, MARQUEE_MAX_WIDTH);
+  marqueePeriod = stripWidth + MARQUEE_GAP;
+  memset(marqueeStrip, 0, sizeof(marqueeStrip));
+
+  uint8_t* buf = u8g2.getBufferPtr();
+  u8g2.setDrawColor(1);
+  for (int chunk = 0; chunk < stripWidth; chunk += SCREEN_WIDTH) {
+    memset(buf, 0, MARQUEE_PAGES * SCREEN_WIDTH);
+    u8g2.drawUTF8(-chunk, 18, currentSong);
+    int columns = min(SCREEN_WIDTH, stripWidth - chunk);
+    for (int page = 0; page < MARQUEE_PAGES; page++) {
+      memcpy(marqueeStrip + page * MARQUEE_MAX_WIDTH + chunk, buf + page * SCREEN_WIDTH, columns);
+    }
+  }
+  memset(buf, 0, MARQUEE_PAGES * SCREEN_WIDTH);
+}
+
+// OR a window of the title strip into the frame buffer from column x to the right edge
+void blitMarquee(int x, int offset) {
+  uint8_t* buf = u8g2.getBufferPtr();
+  int src = offset;
+  for (int col = x; col < SCREEN_WIDTH; col++) {
+    if (src < MARQUEE_MAX_WIDTH) {
+      for (int page = 0; page < MARQUEE_PAGES; page++) {
+        buf[page * SCREEN_WIDTH + col] |= marqueeStrip[page * MARQUEE_MAX_WIDTH + src];
+      }
+    }
+    if (++src >= marqueePeriod) src = 0;
+  }
+}
+
+// ---- main render ----
+void displayMusicFace() {
+  // Layout renders through the frame buffer, so it runs before this frame is drawn
+  if (!musicLayoutValid) layoutMusicText(SCREEN_WIDTH - 50);
+
+  u8g2.clearBuffer();
 
   // === left circle ===
   const int r = 20;
@@ -707,54 +1715,26 @@ void displayMusicFace() {
   u8g2.drawDisc(cx, cy, r);
 
   u8g2.setDrawColor(0);
-  drawRotatingMusicNote(cx - noteW / 2, cy - noteH / 2, musicPlaying);
+  drawRotatingMusicNote(cx - noteW / 2, cy - noteH / 2);
 
   // === right text ===
   const int rightX = 50;
-  const int rightW = SCREEN_WIDTH - rightX;
 
-  // Enable clipping for the right area only
-  u8g2.setClipWindow(rightX, 0, SCREEN_WIDTH - 1, SCREEN_HEIGHT - 1);
-
-  // Song name with scrolling
+  // Song name, scrolled through the pre-rendered strip when too long
   u8g2.setDrawColor(1);
-  u8g2.setFont(u8g2_font_ncenB10_tf);
-  int songW = u8g2.getUTF8Width(currentSong.c_str());
-  if (songW <= rightW) {
-    u8g2.drawUTF8(rightX, 18, currentSong.c_str());
+  if (marqueePeriod == 0) {
+    u8g2.setFont(u8g2_font_ncenB10_tf);
+    u8g2.drawUTF8(rightX, 18, currentSong);
   } else {
-    scrollOffset = (scrollOffset + 1) % (songW + 20);
-    int x = rightX - scrollOffset;
-    u8g2.drawUTF8(x, 18, currentSong.c_str());
-    u8g2.drawUTF8(x + songW + 20, 18, currentSong.c_str());
+    scrollOffset = (scrollOffset + 1) % marqueePeriod;
+    blitMarquee(rightX, scrollOffset);
+    scheduleRenderIn(MUSIC_SCROLL_INTERVAL);
   }
-  
-  // Disable clipping for the rest
-  u8g2.setMaxClipWindow();
 
-  // Album + artist with ellipses if too long
+  // Album + artist, already ellipsized
   u8g2.setFont(u8g2_font_6x12_tf);
-
-  String albumStr = currentAlbum;
-  int albumW = u8g2.getUTF8Width(albumStr.c_str());
-  if (albumW > rightW) {
-    // shrink until it fits with ".."
-    while (albumStr.length() > 0 && u8g2.getUTF8Width((albumStr + "..").c_str()) > rightW) {
-      albumStr.remove(albumStr.length() - 1);
-    }
-    albumStr += "..";
-  }
-  u8g2.drawUTF8(rightX, 30, albumStr.c_str());
-
-  String artistStr = currentArtist;
-  int artistW = u8g2.getUTF8Width(artistStr.c_str());
-  if (artistW > rightW) {
-    while (artistStr.length() > 0 && u8g2.getUTF8Width((artistStr + "..").c_str()) > rightW) {
-      artistStr.remove(artistStr.length() - 1);
-    }
-    artistStr += "..";
-  }
-  u8g2.drawUTF8(rightX, 42, artistStr.c_str());
+  u8g2.drawUTF8(rightX, 30, musicAlbumLine);
+  u8g2.drawUTF8(rightX, 42, musicArtistLine);
 
   if (selectedMusicSubstate == SEEK) {
     // === seek bar ===
@@ -776,7 +1756,18 @@ void displayMusicFace() {
     drawMaxIcon(116, 56);
   }
 
-  u8g2.sendBuffer();
+  flushDisplay();
+}
+
+// Scheduled every frameInterval while music plays, so the note turns at its own
+// rate however often the face redraws. The redraw also moves the seek bar.
+void advanceMusicNote() {
+  if (!musicPlaying) {
+    cancelTask(advanceMusicNote);
+    return;
+  }
+  currentFrame = (currentFrame + 1) % MUSIC_NOTE_FRAMES;
+  invalidateRender(DEP_MUSIC);
 }
 
 void displayNotificationsFace() {
@@ -791,13 +1782,19 @@ void displayNotificationsFace() {
     int y = 12;
 
     for (int i = startIdx; i < min(startIdx + 5, notificationCount); i++) {
-      String notifText = notifications[i].app + ": " + notifications[i].title;
-      u8g2.drawStr(2, y, notifText.substring(0, 20).c_str());
+      const Notification& n = notificationAt(i);
+      char notifText[21];
+      if (n.repeats > 1) {
+        snprintf(notifText, sizeof(notifText), "%ux %s: %s", n.repeats, notificationApp(n), notificationTitle(n));
+      } else {
+        snprintf(notifText, sizeof(notifText), "%s: %s", notificationApp(n), notificationTitle(n));
+      }
+      u8g2.drawStr(2, y, notifText);
       y += 12;
     }
   }
 
-  u8g2.sendBuffer();
+  flushDisplay();
 }
 
 void handleTimerState() {
@@ -805,7 +1802,7 @@ void handleTimerState() {
     case TIMER_SELECT: displayTimerSelect(); break;
     case TIMER_SETUP: displayTimerSetup(); break;
     case TIMER_RUNNING:
-    case TIMER_PAUSED: displayTimerRunning(); updateTimer(); break;
+    case TIMER_PAUSED: displayTimerRunning(); break;
     case TIMER_FINISHED: displayTimerFinished(); break;
   }
 }
@@ -822,7 +1819,7 @@ void displayTimerSelect() {
     else u8g2.drawStr(20, 32 + i * 14, types[i]);
   }
 
-  u8g2.sendBuffer();
+  flushDisplay();
 }
 
 // === Timer Setup Screen ===
@@ -837,7 +1834,7 @@ void displayTimerSetup() {
   int w = u8g2.getStrWidth(minStr.c_str());
   u8g2.drawStr((128 - w) / 2, 46, minStr.c_str());
 
-  u8g2.sendBuffer();
+  flushDisplay();
 }
 
 // === Timer Running Screen ===
@@ -886,7 +1883,15 @@ void displayTimerRunning() {
     u8g2.drawStr((128 - mw) / 2, 62, modeStr);
   }
 
-  u8g2.sendBuffer();
+  flushDisplay();
+
+  if (timerRunning) {
+    // Redraw when the displayed second rolls over, or sooner if the progress bar moves first
+    unsigned long elapsed = millis() - timerStartTime + timerElapsed;
+    unsigned long untilNextSecond = selectedTimerType == STOPWATCH ? 1000 - elapsed % 1000 : value % 1000 + 1;
+    if (selectedTimerType != STOPWATCH) untilNextSecond = min(untilNextSecond, max(timerDuration / 118, 1UL));
+    scheduleRenderIn(untilNextSecond);
+  }
 }
 
 // === Timer Finished Screen ===
@@ -900,14 +1905,16 @@ void displayTimerFinished() {
   u8g2.setFont(u8g2_font_6x10_tf);
   u8g2.drawStr(25, 55, "Click knob to reset");
 
-  u8g2.sendBuffer();
+  flushDisplay();
+}
 
-  // alarm beep
-  static unsigned long lastBeep = 0;
-  if (millis() - lastBeep > 1000) {
-    playTone(1000, 200);
-    lastBeep = millis();
+// Scheduled every TIMER_ALARM_INTERVAL from the moment a countdown finishes
+void updateTimerAlarm() {
+  if (timerState != TIMER_FINISHED) {
+    cancelTask(updateTimerAlarm);
+    return;
   }
+  if (currentState == TIMER && !isAsleep) playTone(1000, 200);  // alarm beep
 }
 
 void displayEventsFace() {
@@ -938,7 +1945,7 @@ void displayEventsFace() {
       u8g2.drawStr(timeColWidth - timeWidth, y, timeBuf);
 
       // Event name
-      u8g2.drawStr(nameStartX, y, eventNames[i].c_str());
+      u8g2.drawStr(nameStartX, y, eventNames[i]);
 
       // Reset draw color
       if (i == selectedEventIndex) {
@@ -947,7 +1954,7 @@ void displayEventsFace() {
     }
   }
 
-  u8g2.sendBuffer();
+  flushDisplay();
 }
 
 void displayMenu() {
@@ -973,7 +1980,7 @@ void displayMenu() {
   int rightArrowX = SCREEN_WIDTH - 20;
   u8g2.drawTriangle(rightArrowX, arrowY, rightArrowX - 6, arrowY - 5, rightArrowX - 6, arrowY + 5);
 
-  u8g2.sendBuffer();
+  flushDisplay();
 }
 
 int faceIconSize = 24;
@@ -988,14 +1995,14 @@ void displayMenuItemIcon(int index) {
   int startY = centerY - faceIconSize / 2;
 
   switch (index) {
-    case 0: u8g2.drawXBM(startX, startY, faceIconSize, faceIconSize, idleFace); break;
-    case 1: u8g2.drawXBM(startX, startY, faceIconSize, faceIconSize, clockFace); break;
-    case 2: u8g2.drawXBM(startX, startY, faceIconSize, faceIconSize, musicFace); break;
-    case 3: u8g2.drawXBM(startX, startY, faceIconSize, faceIconSize, notifFace); break;
-    case 4: u8g2.drawXBM(startX, startY, faceIconSize, faceIconSize, timerFace); break;
-    case 5: u8g2.drawXBM(startX, startY, faceIconSize, faceIconSize, eventsFace); break;
-    case 6: u8g2.drawXBM(startX, startY, faceIconSize, faceIconSize, sleepFace); break;
-    case 7: u8g2.drawXBM(startX, startY, faceIconSize, faceIconSize, gamesFace); break;
+    case 0: drawPackedSprite(startX, startY, idleFace, 0); break;
+    case 1: drawPackedSprite(startX, startY, clockFace, 0); break;
+    case 2: drawPackedSprite(startX, startY, musicFace, 0); break;
+    case 3: drawPackedSprite(startX, startY, notifFace, 0); break;
+    case 4: drawPackedSprite(startX, startY, timerFace, 0); break;
+    case 5: drawPackedSprite(startX, startY, eventsFace, 0); break;
+    case 6: drawPackedSprite(startX, startY, sleepFace, 0); break;
+    case 7: drawPackedSprite(startX, startY, gamesFace, 0); break;
   }
 }
 
@@ -1013,21 +2020,30 @@ void displayNotificationPopup() {
     u8g2.drawStr(5, 30 + i * 12, lines[i].c_str());
   }
 
-  u8g2.sendBuffer();
+  flushDisplay();
 }
 
 // === PONG GAME IMPLEMENTATION ===
 void initializePongGame() {
-  pongGame.ballX = SCREEN_WIDTH / 2.0;
-  pongGame.ballY = SCREEN_HEIGHT / 2.0;
+  pongGame.ballX = PONG_FP(SCREEN_WIDTH / 2);
+  pongGame.ballY = PONG_FP(SCREEN_HEIGHT / 2);
   pongGame.ballVelX = PongGame::BALL_SPEED;
   pongGame.ballVelY = PongGame::BALL_SPEED;
-  pongGame.leftPaddleY = SCREEN_HEIGHT / 2.0;
-  pongGame.rightPaddleY = SCREEN_HEIGHT / 2.0;
+  pongGame.ballSpeed = PongGame::BALL_SPEED;
+  pongGame.leftPaddleY = PONG_FP(SCREEN_HEIGHT / 2);
+  pongGame.rightPaddleY = PONG_FP(SCREEN_HEIGHT / 2);
+  pongGame.prevBallX = pongGame.ballX;
+  pongGame.prevBallY = pongGame.ballY;
+  pongGame.prevLeftPaddleY = pongGame.leftPaddleY;
+  pongGame.prevRightPaddleY = pongGame.rightPaddleY;
+  pongGame.inputCount = 0;
+  pongGame.tick = 0;
   pongGame.leftScore = 0;
   pongGame.rightScore = 0;
   pongGame.gameActive = false;
   pongGame.lastUpdate = millis();
+  pongGame.accumulator = 0;
+  pongGame.rng = esp_random() | 1;  // xorshift must not start at 0
 }
 
 void handleGameState() {
@@ -1038,6 +2054,7 @@ void handleGameState() {
     case GAME_PLAYING:
       updatePongGame();
       displayPongGame();
+      scheduleRenderIn(0);  // physics runs on its own tick; frames interpolate
       break;
     case GAME_PAUSED:
       displayPongPaused();
@@ -1059,22 +2076,29 @@ void displayGameMenu() {
   
   u8g2.drawStr(15, 60, "Rotate: Select, Click: Start");
   
-  u8g2.sendBuffer();
+  flushDisplay();
 }
 
 void displayPongGame() {
   u8g2.clearBuffer();
   
+  // Draw between the last two ticks by the fraction of a tick not yet simulated
+  int32_t alpha = (pongGame.accumulator << PONG_FP_SHIFT) / PONG_TICK_MS;
+  int leftPaddleY = pongLerp(pongGame.prevLeftPaddleY, pongGame.leftPaddleY, alpha);
+  int rightPaddleY = pongLerp(pongGame.prevRightPaddleY, pongGame.rightPaddleY, alpha);
+  int ballX = pongLerp(pongGame.prevBallX, pongGame.ballX, alpha);
+  int ballY = pongLerp(pongGame.prevBallY, pongGame.ballY, alpha);
+
   // Draw paddles
-  u8g2.drawBox(2, pongGame.leftPaddleY - PongGame::PADDLE_HEIGHT/2, 
+  u8g2.drawBox(2, leftPaddleY - PongGame::PADDLE_HEIGHT/2, 
                PongGame::PADDLE_WIDTH, PongGame::PADDLE_HEIGHT);
   u8g2.drawBox(SCREEN_WIDTH - 2 - PongGame::PADDLE_WIDTH, 
-               pongGame.rightPaddleY - PongGame::PADDLE_HEIGHT/2, 
+               rightPaddleY - PongGame::PADDLE_HEIGHT/2, 
                PongGame::PADDLE_WIDTH, PongGame::PADDLE_HEIGHT);
   
   // Draw ball
-  u8g2.drawBox(pongGame.ballX - PongGame::BALL_SIZE/2, 
-               pongGame.ballY - PongGame::BALL_SIZE/2, 
+  u8g2.drawBox(ballX - PongGame::BALL_SIZE/2, 
+               ballY - PongGame::BALL_SIZE/2, 
                PongGame::BALL_SIZE, PongGame::BALL_SIZE);
   
   // Draw center line
@@ -1087,7 +2111,7 @@ void displayPongGame() {
   u8g2.drawStr(SCREEN_WIDTH/2 - 20, 12, String(pongGame.leftScore).c_str());
   u8g2.drawStr(SCREEN_WIDTH/2 + 15, 12, String(pongGame.rightScore).c_str());
   
-  u8g2.sendBuffer();
+  flushDisplay();
 }
 
 void displayPongPaused() {
@@ -1095,7 +2119,7 @@ void displayPongPaused() {
   u8g2.setFont(u8g2_font_6x10_tf);
   u8g2.drawStr(40, 30, "PAUSED");
   u8g2.drawStr(20, 45, "Click to resume");
-  u8g2.sendBuffer();
+  flushDisplay();
 }
 
 void displayPongGameOver() {
@@ -1113,58 +2137,80 @@ void displayPongGameOver() {
   u8g2.drawStr(10, 50, ("Score: " + String(pongGame.leftScore) + " - " + String(pongGame.rightScore)).c_str());
   u8g2.drawStr(20, 62, "Click to restart");
   
-  u8g2.sendBuffer();
+  flushDisplay();
 }
 
 void updatePongGame() {
   if (!pongGame.gameActive) return;
   
   unsigned long currentTime = millis();
-  float deltaTime = (currentTime - pongGame.lastUpdate) / 1000.0;
+  pongGame.accumulator += currentTime - pongGame.lastUpdate;
   pongGame.lastUpdate = currentTime;
-  
-  // Update ball position
-  pongGame.ballX += pongGame.ballVelX;
-  pongGame.ballY += pongGame.ballVelY;
-  
-  // Ball collision with top/bottom walls
-  if (pongGame.ballY <= PongGame::BALL_SIZE/2 || pongGame.ballY >= SCREEN_HEIGHT - PongGame::BALL_SIZE/2) {
-    pongGame.ballVelY = -pongGame.ballVelY;
+  if (pongGame.accumulator > PONG_TICK_MS * PONG_MAX_TICKS) {
+    pongGame.accumulator = PONG_TICK_MS * PONG_MAX_TICKS;
   }
   
-  // Ball collision with left paddle
-  if (pongGame.ballX <= 2 + PongGame::PADDLE_WIDTH + PongGame::BALL_SIZE/2 &&
-      pongGame.ballY >= pongGame.leftPaddleY - PongGame::PADDLE_HEIGHT/2 &&
-      pongGame.ballY <= pongGame.leftPaddleY + PongGame::PADDLE_HEIGHT/2 &&
-      pongGame.ballVelX < 0) {
-    bounceOffPaddle(pongGame.leftPaddleY);
-    playTone(800, 50);
+  while (pongGame.accumulator >= PONG_TICK_MS && gameState == GAME_PLAYING) {
+    stepPong();
+    pongGame.accumulator -= PONG_TICK_MS;
   }
+}
+
+// One fixed physics tick
+void stepPong() {
+  pongGame.prevBallX = pongGame.ballX;
+  pongGame.prevBallY = pongGame.ballY;
+  pongGame.prevLeftPaddleY = pongGame.leftPaddleY;
+  pongGame.prevRightPaddleY = pongGame.rightPaddleY;
   
-  // Ball collision with right paddle
-  if (pongGame.ballX >= SCREEN_WIDTH - 2 - PongGame::PADDLE_WIDTH - PongGame::BALL_SIZE/2 &&
-      pongGame.ballY >= pongGame.rightPaddleY - PongGame::PADDLE_HEIGHT/2 &&
-      pongGame.ballY <= pongGame.rightPaddleY + PongGame::PADDLE_HEIGHT/2 &&
-      pongGame.ballVelX > 0) {
-    bounceOffPaddle(pongGame.rightPaddleY);
-    playTone(800, 50);
-  }
+  // Encoder input lands on the tick it arrived in so a recorded input trace replays exactly
+  int left = 0, right = 0, used = 0;
+  while (used < pongGame.inputCount && pongGame.inputs[used].tick <= pongGame.tick) {
+    left += pongGame.inputs[used].left;
+    right += pongGame.inputs[used].right;
+    used++;
+  }
+  pongGame.inputCount -= used;
+  memmove(pongGame.inputs, pongGame.inputs + used, pongGame.inputCount * sizeof(PongInput));
+  pongGame.tick++;
+  movePongPaddle(pongGame.leftPaddleY, left * PongGame::PADDLE_SPEED);
+  movePongPaddle(pongGame.rightPaddleY, right * PongGame::PADDLE_SPEED);
   
   // AI for single player mode (right paddle)
   if (gameMode == 1) {
-    float aiSpeed = PongGame::PADDLE_SPEED * 0.7; // Make AI slightly slower
-    if (pongGame.ballY < pongGame.rightPaddleY - 5) {
-      pongGame.rightPaddleY -= aiSpeed;
-    } else if (pongGame.ballY > pongGame.rightPaddleY + 5) {
-      pongGame.rightPaddleY += aiSpeed;
+    if (pongGame.ballY < pongGame.rightPaddleY - PONG_FP(5)) {
+      movePongPaddle(pongGame.rightPaddleY, -PongGame::AI_SPEED);
+    } else if (pongGame.ballY > pongGame.rightPaddleY + PONG_FP(5)) {
+      movePongPaddle(pongGame.rightPaddleY, PongGame::AI_SPEED);
     }
-    
-    // Keep AI paddle in bounds
-    pongGame.rightPaddleY = constrain(pongGame.rightPaddleY, 
-                                     PongGame::PADDLE_HEIGHT/2, 
-                                     SCREEN_HEIGHT - PongGame::PADDLE_HEIGHT/2);
   }
   
+  int32_t x0 = pongGame.ballX, y0 = pongGame.ballY;
+  int32_t x1 = x0 + pongGame.ballVelX, y1 = y0 + pongGame.ballVelY;
+  
+  // Paddles: test where the step crosses each face, so a fast ball can't skip past one
+  const int32_t leftFace = PONG_FP(2 + PongGame::PADDLE_WIDTH + PongGame::BALL_SIZE/2);
+  const int32_t rightFace = PONG_FP(SCREEN_WIDTH - 2 - PongGame::PADDLE_WIDTH - PongGame::BALL_SIZE/2);
+  if (pongGame.ballVelX < 0 && x0 >= leftFace && x1 < leftFace) {
+    if (sweepPongPaddle(leftFace, pongGame.leftPaddleY, x0, y0, x1, y1)) playTone(800, 50);
+  } else if (pongGame.ballVelX > 0 && x0 <= rightFace && x1 > rightFace) {
+    if (sweepPongPaddle(rightFace, pongGame.rightPaddleY, x0, y0, x1, y1)) playTone(800, 50);
+  }
+  
+  // Walls: reflect the overshoot so the ball never ends a tick inside one
+  const int32_t top = PONG_FP(PongGame::BALL_SIZE/2);
+  const int32_t bottom = PONG_FP(SCREEN_HEIGHT - PongGame::BALL_SIZE/2);
+  if (y1 < top) {
+    y1 = 2 * top - y1;
+    pongGame.ballVelY = -pongGame.ballVelY;
+  } else if (y1 > bottom) {
+    y1 = 2 * bottom - y1;
+    pongGame.ballVelY = -pongGame.ballVelY;
+  }
+  
+  pongGame.ballX = x1;
+  pongGame.ballY = y1;
+  
   // Score detection
   if (pongGame.ballX < 0) {
     pongGame.rightScore++;
@@ -1174,7 +2220,7 @@ void updatePongGame() {
     if (pongGame.rightScore >= 3) {
       gameState = GAME_OVER;
     }
-  } else if (pongGame.ballX > SCREEN_WIDTH) {
+  } else if (pongGame.ballX > PONG_FP(SCREEN_WIDTH)) {
     pongGame.leftScore++;
     resetBall();
     playTone(600, 200);
@@ -1185,97 +2231,198 @@ void updatePongGame() {
   }
 }
 
-// Adjust bounce angle + increase speed over time
-void bounceOffPaddle(float paddleY) {
-  // relative hit position: -1.0 (top) → 0 (center) → +1.0 (bottom)
-  float relativeY = (pongGame.ballY - paddleY) / (PongGame::PADDLE_HEIGHT / 2.0);
+// Paddle steps for the tick running at millis(): every tick the next frame would simulate
+// before now is already behind it
+void queuePongInput(int left, int right) {
+  uint32_t pending = pongGame.accumulator + (millis() - pongGame.lastUpdate);
+  uint32_t tick = pongGame.tick + min(pending / PONG_TICK_MS, (uint32_t)PONG_MAX_TICKS);
 
-  // max bounce angle ~ 60 degrees
-  float maxAngle = PI / 3; 
-  float bounceAngle = relativeY * maxAngle;
+  PongInput* last = pongGame.inputCount ? &pongGame.inputs[pongGame.inputCount - 1] : nullptr;
+  if (!last || (last->tick != tick && pongGame.inputCount < PONG_INPUT_SLOTS)) {
+    last = &pongGame.inputs[pongGame.inputCount++];
+    *last = { tick, 0, 0 };
+  }
+  last->left += left;
+  last->right += right;
+}
+
+void movePongPaddle(int32_t& paddleY, int32_t delta) {
+  paddleY = constrain(paddleY + delta, PONG_FP(PongGame::PADDLE_HEIGHT/2), PONG_FP(SCREEN_HEIGHT - PongGame::PADDLE_HEIGHT/2));
+}
+
+// If the step x0,y0 -> x1,y1 meets the paddle at 'face', bounce and spend the rest of the step on the new velocity
+bool sweepPongPaddle(int32_t face, int32_t paddleY, int32_t x0, int32_t y0, int32_t& x1, int32_t& y1) {
+  int32_t t = (int32_t)(((int64_t)(x0 - face) << PONG_FP_SHIFT) / (x0 - x1));  // Q8 fraction of the step
+  int32_t hitY = y0 + (int32_t)(((int64_t)(y1 - y0) * t) >> PONG_FP_SHIFT);
+  int32_t offset = hitY - paddleY;
+  if (offset < -PONG_FP(PongGame::PADDLE_HEIGHT/2) || offset > PONG_FP(PongGame::PADDLE_HEIGHT/2)) return false;
+  
+  bounceOffPaddle(offset);
+  int32_t remaining = PONG_FP(1) - t;
+  x1 = face + ((pongGame.ballVelX * remaining) >> PONG_FP_SHIFT);
+  y1 = hitY + ((pongGame.ballVelY * remaining) >> PONG_FP_SHIFT);
+  return true;
+}
+
+// Adjust bounce angle + increase speed over time
+void bounceOffPaddle(int32_t offset) {
+  // hit position: top of the paddle -> -60 degrees, centre -> 0, bottom -> +60 degrees
+  int angle = constrain(8 + offset * 8 / PONG_FP(PongGame::PADDLE_HEIGHT/2), 0, 16);
 
   // increase speed gradually (up to a limit)
-  static float currentSpeed = PongGame::BALL_SPEED;
-  currentSpeed *= 1.05;                     // +5% each hit
-  if (currentSpeed > 6.0) currentSpeed = 6.0;  // cap speed
+  pongGame.ballSpeed = min(pongGame.ballSpeed * 269 / 256, PongGame::MAX_BALL_SPEED);  // +5% each hit
 
   // flip X depending on which side
-  float dir = (pongGame.ballVelX > 0) ? -1 : 1;
+  int32_t dir = (pongGame.ballVelX > 0) ? -1 : 1;
 
-  pongGame.ballVelX = dir * currentSpeed * cos(bounceAngle);
-  pongGame.ballVelY = currentSpeed * sin(bounceAngle);
+  pongGame.ballVelX = dir * ((pongGame.ballSpeed * PONG_ANGLE_COS[angle]) >> PONG_FP_SHIFT);
+  pongGame.ballVelY = (pongGame.ballSpeed * PONG_ANGLE_SIN[angle]) >> PONG_FP_SHIFT;
 
   // safeguard: never perfectly flat
-  if (fabs(pongGame.ballVelY) < 0.1) {
-    pongGame.ballVelY = (random(0, 2) == 0 ? 1 : -1) * 0.5;
+  if (abs(pongGame.ballVelY) < PONG_FP(0.1)) {
+    pongGame.ballVelY = (pongRandom() & 1 ? 1 : -1) * PONG_FP(0.5);
   }
 }
 
 void resetBall() {
-  pongGame.ballX = SCREEN_WIDTH / 2;
-  pongGame.ballY = SCREEN_HEIGHT / 2;
+  pongGame.ballX = PONG_FP(SCREEN_WIDTH / 2);
+  pongGame.ballY = PONG_FP(SCREEN_HEIGHT / 2);
+  pongGame.prevBallX = pongGame.ballX;  // don't interpolate across the jump
+  pongGame.prevBallY = pongGame.ballY;
 
-  float angle = random(-45, 45) * PI / 180.0; // random small angle
-  float dir = (random(0, 2) == 0 ? -1 : 1);
+  int angle = 2 + pongRandom() % 13;  // random angle within -45..45 degrees
+  int32_t dir = (pongRandom() & 1) ? -1 : 1;
 
   // reset speed back to base
-  bounceOffPaddle(pongGame.leftPaddleY); // just to use formula
-  pongGame.ballVelX = dir * PongGame::BALL_SPEED * cos(angle);
-  pongGame.ballVelY = PongGame::BALL_SPEED * sin(angle);
+  pongGame.ballSpeed = PongGame::BALL_SPEED;
+  pongGame.ballVelX = dir * ((PongGame::BALL_SPEED * PONG_ANGLE_COS[angle]) >> PONG_FP_SHIFT);
+  pongGame.ballVelY = (PongGame::BALL_SPEED * PONG_ANGLE_SIN[angle]) >> PONG_FP_SHIFT;
 }
 
-// === Encoder 1 ===
-void checkEncoder1() {
-  int newPos = encoder1.getCount() / 4;
+uint32_t pongRandom() {
+  uint32_t x = pongGame.rng;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  pongGame.rng = x;
+  return x;
+}
 
-  if (newPos != encoder1Pos) {
-    handleEncoder1Rotation(newPos - encoder1Pos);
-    encoder1Pos = newPos;
-  }
+// Q8 positions a and b blended by Q8 alpha, in whole pixels
+int pongLerp(int32_t a, int32_t b, int32_t alpha) {
+  return (a + (((b - a) * alpha) >> PONG_FP_SHIFT)) >> PONG_FP_SHIFT;
+}
 
-  static unsigned long lastClickTime1 = 0;
+// === Input Events ===
+void IRAM_ATTR encoder1ButtonISR() {
+  InputEvent event = { 0, digitalRead(ENCODER1_BTN) ? INPUT_RELEASE : INPUT_PRESS, 0, (uint32_t)millis() };
+  portENTER_CRITICAL_ISR(&inputMux);
+  enqueueInputEvent(event);
+  portEXIT_CRITICAL_ISR(&inputMux);
+  wakeLoopFromISR();
+}
 
-  if (encoder1LongPress) {
-    handleEncoder1LongPress();
-    encoder1LongPress = false;
-  } else if (encoder1BtnPressed && millis() - encoder1BtnStart < 50) {
-    if (millis() - lastClickTime1 > debounceDelay) {
-      handleEncoder1Click();
-      lastClickTime1 = millis();
-    }
+void IRAM_ATTR encoder2ButtonISR() {
+  InputEvent event = { 1, digitalRead(ENCODER2_BTN) ? INPUT_RELEASE : INPUT_PRESS, 0, (uint32_t)millis() };
+  portENTER_CRITICAL_ISR(&inputMux);
+  enqueueInputEvent(event);
+  portEXIT_CRITICAL_ISR(&inputMux);
+  wakeLoopFromISR();
+}
+
+// Caller holds inputMux
+void IRAM_ATTR enqueueInputEvent(const InputEvent& event) {
+  uint8_t next = (inputHead + 1) % INPUT_QUEUE_SIZE;
+  if (next == inputTail) {
+    inputDropped++;
+    return;
   }
+  inputQueue[inputHead] = event;
+  inputHead = next;
 }
 
-// === Encoder 2 ====
-void checkEncoder2() {
-  int newPos = encoder2.getCount() / 4;
+bool popInputEvent(InputEvent& event) {
+  bool available = false;
+  portENTER_CRITICAL(&inputMux);
+  if (inputTail != inputHead) {
+    event = inputQueue[inputTail];
+    inputTail = (inputTail + 1) % INPUT_QUEUE_SIZE;
+    available = true;
+  }
+  portEXIT_CRITICAL(&inputMux);
+  return available;
+}
+
+// The PCNT units count every detent in hardware; turn new counts into events
+void pollEncoderRotation() {
+  int positions[2] = { (int)(encoder1.getCount() / 4), (int)(encoder2.getCount() / 4) };
+  int* lastPositions[2] = { &encoder1Pos, &encoder2Pos };
 
-  if (newPos != encoder2Pos) {
-    handleEncoder2Rotation(newPos - encoder2Pos);
-    encoder2Pos = newPos;
+  for (uint8_t encoder = 0; encoder < 2; encoder++) {
+    int steps = positions[encoder] - *lastPositions[encoder];
+    if (steps == 0) continue;
+    *lastPositions[encoder] = positions[encoder];
+
+    InputEvent event = { encoder, INPUT_ROTATE, (int16_t)steps, (uint32_t)millis() };
+    portENTER_CRITICAL(&inputMux);
+    enqueueInputEvent(event);
+    portEXIT_CRITICAL(&inputMux);
   }
+}
 
-  static unsigned long lastClickTime2 = 0;
+void dispatchInputEvent(const InputEvent& event) {
+  ButtonState& button = buttons[event.encoder];
 
-  if (encoder2LongPress) {
-    handleEncoder2LongPress();
-    encoder2LongPress = false;
-  } else if (encoder2BtnPressed && millis() - encoder2BtnStart < 50) {
-    if (millis() - lastClickTime2 > debounceDelay) {
-      handleEncoder2Click();
-      lastClickTime2 = millis();
-    }
+  switch (event.type) {
+    case INPUT_ROTATE:
+      eyes.cancel();  // input is answered on the next frame, not after the expression
+      if (event.encoder == 0) handleEncoder1Rotation(event.steps);
+      else handleEncoder2Rotation(event.steps);
+      invalidateRender(DEP_INPUT);
+      break;
+
+    case INPUT_PRESS:
+      if (button.pressed || event.time - button.lastEdge < BUTTON_DEBOUNCE) break;
+      button.pressed = true;
+      button.longPressFired = false;
+      button.pressTime = event.time;
+      button.lastEdge = event.time;
+      break;
+
+    case INPUT_RELEASE:
+      if (!button.pressed || event.time - button.lastEdge < BUTTON_DEBOUNCE) break;
+      button.pressed = false;
+      button.lastEdge = event.time;
+      if (button.longPressFired) break;
+
+      if (event.time - button.pressTime >= LONG_PRESS_TIME) {
+        // Held long enough but released before the loop got to it
+        fireEncoderLongPress(event.encoder);
+      } else {
+        eyes.cancel();
+        if (event.encoder == 0) handleEncoder1Click();
+        else handleEncoder2Click();
+        invalidateRender(DEP_INPUT);
+      }
+      break;
   }
 }
 
+void fireEncoderLongPress(uint8_t encoder) {
+  eyes.cancel();
+  if (encoder == 0) handleEncoder1LongPress();
+  else handleEncoder2LongPress();
+  invalidateRender(DEP_INPUT);
+}
+
 void handleEncoder1Rotation(int direction) {
   switch (currentState) {
     case MUSIC:
-      // Previous/Next song
+      // Previous/Next song, one skip per detent
       if (direction > 0) {
-        sendBLECommand("MUSIC_NEXT");
+        queueBLECommand(MSG_MUSIC_NEXT, direction, nullptr);
       } else {
-        sendBLECommand("MUSIC_PREV");
+        queueBLECommand(MSG_MUSIC_PREV, -direction, nullptr);
       }
       break;
     case NOTIFICATIONS:
@@ -1285,9 +2432,8 @@ void handleEncoder1Rotation(int direction) {
       if (gameState == GAME_MENU) {
         gameMode = constrain(gameMode + direction, 1, 2);
       } else if (gameState == GAME_PLAYING && pongGame.gameActive) {
-        // Move left paddle
-        pongGame.leftPaddleY -= direction * PongGame::PADDLE_SPEED;
-        pongGame.leftPaddleY = constrain(pongGame.leftPaddleY, PongGame::PADDLE_HEIGHT/2, SCREEN_HEIGHT - PongGame::PADDLE_HEIGHT/2);
+        // Move left paddle on the physics tick running now
+        queuePongInput(-direction, 0);
       }
       break;
   }
@@ -1303,7 +2449,8 @@ void handleEncoder1Click() {
     case MUSIC:
       // Play/Pause
       musicPlaying = !musicPlaying;
-      sendBLECommand(musicPlaying ? "MUSIC_PLAY" : "MUSIC_PAUSE");
+      if (musicPlaying) scheduleTask(advanceMusicNote, frameInterval, frameInterval);
+      queueBLECommand(musicPlaying ? MSG_MUSIC_PLAY : MSG_MUSIC_PAUSE, 0, nullptr);
       break;
     case NOTIFICATIONS:
     case EVENTS:
@@ -1356,23 +2503,19 @@ void handleEncoder1LongPress() {
 }
 
 int seekDuration = 5000; // 5 seconds
-int seekTimer = 500; // 0.5s
-int relativeMillis = 0;
-unsigned long lastSeek = millis();
 
 void updateSeek() {
   unsigned long now = millis();
-
-  if (musicPlaying) {
-    playbackPosition += now - lastPlaybackUpdate;
-    if (playbackPosition > songDuration)
-      playbackPosition = songDuration;
-  }
-  lastPlaybackUpdate = now;
-
-  if (relativeMillis != 0 && millis() - lastSeek >= seekTimer) {
-    sendBLECommand("MUSIC_SEEK_RELATIVE:" + String(relativeMillis));
-    relativeMillis = 0;
+  unsigned long elapsed = now - lastPlaybackUpdate;
+
+  // Interpolate between syncs, absorbing drift at up to a quarter of real time
+  if (elapsed >= PLAYBACK_STEP) {
+    if (musicPlaying) {
+      long correction = constrain(playbackDrift, -(long)elapsed / 4, (long)elapsed / 4);
+      playbackDrift -= correction;
+      playbackPosition = constrain(playbackPosition + (long)elapsed + correction, 0L, (long)songDuration);
+    }
+    lastPlaybackUpdate = now;
   }
 }
 
@@ -1382,12 +2525,11 @@ void handleEncoder2Rotation(int direction) {
       if (selectedMusicSubstate == VOLUME) {
        // volume controls
         musicVolume = constrain(musicVolume + direction * 5, 0, 100);
-        sendBLECommand("MUSIC_VOLUME:" + String(musicVolume));
+        queueBLECommand(MSG_MUSIC_VOLUME, musicVolume, nullptr);
       } else if (selectedMusicSubstate == SEEK) {
         // accumulate relative seek
         playbackPosition = constrain(playbackPosition + direction * seekDuration, 0, songDuration);
-        relativeMillis += direction * seekDuration;
-        lastSeek = millis(); // reset timer
+        queueBLECommand(MSG_MUSIC_SEEK_RELATIVE, direction * seekDuration, nullptr);
       }
       break;
     case EVENTS:
@@ -1409,9 +2551,8 @@ void handleEncoder2Rotation(int direction) {
       break;
     case GAMES:
       if (gameState == GAME_PLAYING && pongGame.gameActive && gameMode == 2) {
-        // Move right paddle (only in 2-player mode)
-        pongGame.rightPaddleY -= direction * PongGame::PADDLE_SPEED;
-        pongGame.rightPaddleY = constrain(pongGame.rightPaddleY, PongGame::PADDLE_HEIGHT/2, SCREEN_HEIGHT - PongGame::PADDLE_HEIGHT/2);
+        // Move right paddle on the physics tick running now (only in 2-player mode)
+        queuePongInput(0, -direction);
       }
       break;
   }
@@ -1426,8 +2567,6 @@ void handleEncoder2Click() {
   switch (currentState) {
     case IDLE:
       eyes.happy();
-      delay(2000);
-      eyes.reset();
       break;
     case MUSIC:
       selectedMusicSubstate = selectedMusicSubstate == SEEK ? VOLUME : SEEK;
@@ -1452,12 +2591,11 @@ void handleEncoder2Click() {
       currentState = TIMER;
 
       // Notify phone app
-      String msg = "EVENT_COMPLETE:" + eventNames[selectedEventIndex];
-      sendBLECommand(msg.c_str());
+      queueBLECommand(MSG_EVENT_COMPLETE, 0, eventNames[selectedEventIndex]);
 
       // Remove the event from the list
       for (int i = selectedEventIndex; i < numEvents - 1; i++) {
-        eventNames[i] = eventNames[i + 1];
+        memcpy(eventNames[i], eventNames[i + 1], EVENT_NAME_MAX);
         eventDurations[i] = eventDurations[i + 1];
       }
       numEvents--;
@@ -1533,6 +2671,8 @@ void updateTimer() {
   if (totalElapsed >= timerDuration) {
     timerRunning = false;
     timerState = TIMER_FINISHED;
+    invalidateRender(DEP_TIMER);
+    scheduleTask(updateTimerAlarm, 0, TIMER_ALARM_INTERVAL);
 
     if (selectedTimerType == POMODORO)
       handlePomodoroComplete();
@@ -1552,9 +2692,14 @@ void handlePomodoroComplete() {
     pomodoroOnBreak = false;
   }
 
-  // Auto-start next timer
-  delay(2000); // Show "FINISHED!" screen for 2s
+  // Auto-start next timer once the "FINISHED!" screen has shown for 2s
+  scheduleTask(autoStartPomodoro, POMODORO_AUTOSTART_DELAY, 0);
+}
+
+void autoStartPomodoro() {
+  if (timerState != TIMER_FINISHED) return;  // user dismissed the finished screen
   startTimer();
+  invalidateRender(DEP_TIMER);
 }
 
 // === Utility Functions ===
@@ -1591,57 +2736,256 @@ int wrapText(String text, int maxChars, String* lines, int maxLines) {
   return lineCount;
 }
 
-void addNotification(String app, String title, String content) {
-  // Shift notifications if array is full
-  if (notificationCount >= MAX_NOTIFICATIONS) {
-    for (int i = 0; i < MAX_NOTIFICATIONS - 1; i++) {
-      notifications[i] = notifications[i + 1];
+const char* notificationApp(const Notification& n) {
+  return notificationArena + n.offset;
+}
+
+const char* notificationTitle(const Notification& n) {
+  return notificationArena + n.offset + n.titleStart;
+}
+
+const char* notificationContent(const Notification& n) {
+  return notificationArena + n.offset + n.contentStart;
+}
+
+// i-th visible notification, oldest first
+const Notification& notificationAt(int index) {
+  for (int i = 0; i < notificationSlots; i++) {
+    const Notification& n = notifications[(notificationHead + i) % MAX_NOTIFICATIONS];
+    if (!n.superseded && index-- == 0) return n;
+  }
+  return notifications[notificationHead];
+}
+
+void dropOldestNotification() {
+  if (!notifications[notificationHead].superseded) notificationCount--;
+  notificationHead = (notificationHead + 1) % MAX_NOTIFICATIONS;
+  notificationSlots--;
+}
+
+// Find room for a contiguous text block, evicting the oldest notifications as needed
+uint16_t reserveNotificationText(size_t length) {
+  while (notificationSlots > 0) {
+    uint16_t oldest = notifications[notificationHead].offset;
+    if (notificationArenaTail > oldest) {
+      // Live text spans [oldest, tail): use the end, or wrap to the front
+      if (notificationArenaTail + length <= NOTIF_ARENA_SIZE) return notificationArenaTail;
+      if (length <= oldest) return 0;
+    } else if (notificationArenaTail + length <= oldest) {
+      // Live text wraps around: only the gap before the oldest block is free
+      return notificationArenaTail;
     }
-    notificationCount = MAX_NOTIFICATIONS - 1;
+    dropOldestNotification();
   }
+  return 0;
+}
+
+void addNotification(const char* app, const char* title, const char* content) {
+  size_t appLength = strlen(app) + 1;
+  size_t titleLength = strlen(title) + 1;
+  size_t contentLength = strlen(content) + 1;
+  size_t length = appLength + titleLength + contentLength;
+
+  // Collapse repeats of the same app + title into the newest copy
+  uint8_t repeats = 1;
+  for (int i = 0; i < notificationSlots; i++) {
+    Notification& n = notifications[(notificationHead + i) % MAX_NOTIFICATIONS];
+    if (!n.superseded && strcmp(notificationApp(n), app) == 0 && strcmp(notificationTitle(n), title) == 0) {
+      n.superseded = true;
+      notificationCount--;
+      repeats = n.repeats < 255 ? n.repeats + 1 : 255;
+      break;
+    }
+  }
+
+  if (notificationSlots >= MAX_NOTIFICATIONS) dropOldestNotification();
+  uint16_t offset = reserveNotificationText(length);
 
-  notifications[notificationCount] = { app, title, content, millis() };
+  char* text = notificationArena + offset;
+  memcpy(text, app, appLength);
+  memcpy(text + appLength, title, titleLength);
+  memcpy(text + appLength + titleLength, content, contentLength);
+  notificationArenaTail = offset + length;
+
+  notifications[(notificationHead + notificationSlots) % MAX_NOTIFICATIONS] = {
+    offset, (uint16_t)length, (uint8_t)appLength, (uint8_t)(appLength + titleLength), repeats, false, millis()
+  };
+  notificationSlots++;
   notificationCount++;
+  notificationScrollPos = constrain(notificationScrollPos, 0, max(0, notificationCount - 5));
+  invalidateRender(DEP_NOTIFICATIONS);
 
   // Trigger notification popup
-  currentNotification = app + ": " + title;
+  snprintf(currentNotification, sizeof(currentNotification), "%s: %s", app, title);
   if (!showNotificationPopup && currentState != NOTIFICATION_POPUP) {
     previousState = currentState;
     currentState = NOTIFICATION_POPUP;
     showNotificationPopup = true;
-    notificationPopupStart = millis();
+    scheduleTask(closeNotificationPopup, NOTIFICATION_POPUP_DURATION, 0);
 
     // Notification feedback
     playTone(800, 200);
   }
 }
 
-void parseEvents(String data) {
-  numEvents = 0;
-  selectedEventIndex = 0;
+// === Display Flush ===
+void startDisplayTask() {
+  memcpy(frameBuffers[0], u8g2.getBufferPtr(), sizeof(frameBuffers[0]));
+  u8g2.getU8g2()->tile_buf_ptr = frameBuffers[0];
+  renderTaskHandle = xTaskGetCurrentTaskHandle();
+  xTaskCreatePinnedToCore(displayTask, "display", 4096, nullptr, 2, &displayTaskHandle, 0);
+}
 
-  // Strip prefix
-  data.remove(0, 7); // remove "EVENTS:"
+// Hand the finished frame to displayTask and continue drawing on a copy of it
+void flushDisplay() {
+  uint8_t submitted = drawFrameIndex;
+  uint8_t next = submitted ^ 1;
 
-  int start = 0;
-  while (numEvents < MAX_EVENTS) {
-    int sep = data.indexOf('|', start);
-    String token = (sep == -1) ? data.substring(start) : data.substring(start, sep);
-    if (token.length() == 0) break;
-
-    int parenOpen = token.indexOf('(');
-    int parenClose = token.indexOf(')');
-    if (parenOpen != -1 && parenClose != -1) {
-      eventNames[numEvents] = token.substring(0, parenOpen);
-      String durationStr = token.substring(parenOpen + 1, parenClose);
-      durationStr.replace("m", "");
-      eventDurations[numEvents] = durationStr.toInt();
-      numEvents++;
+  // Replaces a pending frame the display task has not started yet
+  uint8_t slots = frameSlots.load();
+  while (!frameSlots.compare_exchange_weak(slots, (slots & 0xF0) | submitted)) {}
+  xTaskNotifyGive(displayTaskHandle);
+
+  // The other buffer is free once it is neither pending nor being flushed
+  while ((frameSlots.load() >> 4) == next) ulTaskNotifyTake(pdTRUE, 1);
+
+  // Faces and overlays may draw over the previous frame, so start from it
+  memcpy(frameBuffers[next], frameBuffers[submitted], sizeof(frameBuffers[0]));
+  drawFrameIndex = next;
+  u8g2.getU8g2()->tile_buf_ptr = frameBuffers[next];
+}
+
+// Contrast goes through displayTask, which owns the panel
+void setDisplayContrast(uint8_t contrast) {
+  requestedContrast.store(contrast);
+  if (displayTaskHandle) xTaskNotifyGive(displayTaskHandle);
+}
+
+void displayTask(void* param) {
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+    int contrast = requestedContrast.exchange(-1);
+    if (contrast >= 0) u8x8_SetContrast(u8g2.getU8x8(), contrast);
+
+    // Claim the pending frame: pending -> flushing
+    uint8_t slots = frameSlots.load();
+    uint8_t frame;
+    do {
+      frame = slots & 0x0F;
+      if (frame == FRAME_NONE) break;
+    } while (!frameSlots.compare_exchange_weak(slots, frame << 4 | FRAME_NONE));
+    if (frame == FRAME_NONE) continue;
+
+    sendFrame(frameBuffers[frame]);
+
+    slots = frameSlots.load();
+    while (!frameSlots.compare_exchange_weak(slots, FRAME_NONE << 4 | (slots & 0x0F))) {}
+    xTaskNotifyGive(renderTaskHandle);
+  }
+}
+
+bool displayTileChanged(const uint8_t* buf, int page, int tile) {
+  if (!displayShadowValid) return true;
+  int offset = page * SCREEN_WIDTH + tile * 8;
+  return memcmp(buf + offset, displayShadow + offset, 8) != 0;
+}
+
+// Send only the tiles of buf that differ from what the panel shows
+void sendFrame(uint8_t* buf) {
+  unsigned long bytes = 0;
+
+  for (int page = 0; page < DISPLAY_PAGES; page++) {
+    int tile = 0;
+    while (tile < DISPLAY_TILE_COLS) {
+      if (!displayTileChanged(buf, page, tile)) {
+        tile++;
+        continue;
+      }
+
+      // Grow the span while changed tiles are at most FLUSH_MERGE_GAP apart
+      int spanStart = tile;
+      int spanEnd = tile;
+      for (int t = tile + 1; t < DISPLAY_TILE_COLS && t - spanEnd <= FLUSH_MERGE_GAP + 1; t++) {
+        if (displayTileChanged(buf, page, t)) spanEnd = t;
+      }
+
+      int spanTiles = spanEnd - spanStart + 1;
+      int offset = page * SCREEN_WIDTH + spanStart * 8;
+      u8x8_DrawTile(u8g2.getU8x8(), spanStart, page, spanTiles, buf + offset);
+
+      memcpy(displayShadow + offset, buf + offset, spanTiles * 8);
+      bytes += spanTiles * 8;
+      tile = spanEnd + 1;
     }
+  }
 
-    if (sep == -1) break;
-    start = sep + 1;
+  displayShadowValid = true;
+  flushBytesLastFrame = bytes;
+  flushBytesTotal += bytes;
+  flushFrameCount++;
+
+#if DISPLAY_FLUSH_STATS
+  static unsigned long lastStatsPrint = 0;
+  static unsigned long statsBytes = 0, statsFrames = 0;
+  statsBytes += bytes;
+  statsFrames++;
+  if (millis() - lastStatsPrint >= 1000) {
+    Serial.printf("flush: %lu frames, %lu B/frame (full frame = %d B)\n",
+                  statsFrames, statsFrames ? statsBytes / statsFrames : 0, SCREEN_WIDTH * DISPLAY_PAGES);
+    statsBytes = statsFrames = 0;
+    lastStatsPrint = millis();
   }
+#endif
+}
+
+// === Profiler ===
+// Report every phase seen since the last report, in microseconds, then start a new window.
+// p50/p99 are the upper bounds of the log2 buckets they fall in.
+void reportStats(bool toBle) {
+#if ENABLE_PROFILER
+  char line[96];
+  uint32_t cyclesPerMicro = ESP.getCpuFreqMHz();
+  unsigned long now = millis();
+  unsigned long frames = flushFrameCount - profileFramesAtStart;
+  unsigned long window = max(1UL, now - profileWindowStart);
+
+  snprintf(line, sizeof(line), "STATS:fps %lu.%lu over %lus", frames * 1000 / window, frames * 10000 / window % 10, window / 1000);
+  emitStatsLine(line, toBle);
+
+  for (int phase = 0; phase < PHASE_COUNT; phase++) {
+    const ProfileHistogram& histogram = profileHistograms[phase];
+    if (histogram.count == 0) continue;
+
+    uint32_t p50 = 0, p99 = 0, seen = 0;
+    for (int i = 0; i < PROFILE_BUCKETS; i++) {
+      seen += histogram.buckets[i];
+      uint32_t bound = i < 31 ? (2UL << i) : UINT32_MAX;
+      if (!p50 && seen * 2 >= histogram.count) p50 = bound;
+      if (!p99 && seen * 100 >= histogram.count * 99ULL) p99 = bound;
+    }
+    snprintf(line, sizeof(line), "STATS:%s p50<%lu p99<%lu max %lu n %lu", profilePhaseNames[phase],
+             (unsigned long)(p50 / cyclesPerMicro), (unsigned long)(p99 / cyclesPerMicro),
+             (unsigned long)(histogram.max / cyclesPerMicro), (unsigned long)histogram.count);
+    emitStatsLine(line, toBle);
+  }
+
+  memset(profileHistograms, 0, sizeof(profileHistograms));
+  profileWindowStart = now;
+  profileFramesAtStart = flushFrameCount;
+#else
+  emitStatsLine("STATS:profiler disabled", toBle);
+#endif
+}
+
+// Scheduled every STATS_REPORT_INTERVAL when the profiler is built in
+void reportStatsToBle() {
+  if (deviceConnected) reportStats(true);
+}
+
+void emitStatsLine(const char* line, bool toBle) {
+  if (toBle) bleNotify((const uint8_t*)line, strlen(line));
+  else Serial.println(line);
 }
 
 // === Hardware Control Functions ===
@@ -1649,83 +2993,772 @@ void playTone(int frequency, int duration) {
   tone(BUZZER_PIN, frequency, duration);
 }
 
-void sendBLECommand(String command) {
+const char* bleCommandName(BleMessageType command) {
+  switch (command) {
+    case MSG_MUSIC_PLAY:          return "MUSIC_PLAY";
+    case MSG_MUSIC_PAUSE:         return "MUSIC_PAUSE";
+    case MSG_MUSIC_NEXT:          return "MUSIC_NEXT";
+    case MSG_MUSIC_PREV:          return "MUSIC_PREV";
+    case MSG_MUSIC_VOLUME:        return "MUSIC_VOLUME";
+    case MSG_MUSIC_SEEK_RELATIVE: return "MUSIC_SEEK_RELATIVE";
+    case MSG_EVENT_COMPLETE:      return "EVENT_COMPLETE";
+    default:                      return "";
+  }
+}
+
+// Send a command to the phone as a binary frame or, before negotiation, as text.
+// 'text' is used instead of 'value' when not null.
+void sendBLECommand(BleMessageType command, long value, const char* text) {
+  if (!deviceConnected || !txChar) return;
+
+  // A single skip stays a bare command; coalesced skips carry their count
+  bool hasValue = command == MSG_MUSIC_VOLUME || command == MSG_MUSIC_SEEK_RELATIVE ||
+                  ((command == MSG_MUSIC_NEXT || command == MSG_MUSIC_PREV) && value > 1);
+
+  if (bleBinaryProtocol) {
+    FrameWriter frame(command);
+    if (text) frame.putText(1, text);
+    else if (command == MSG_MUSIC_SEEK_RELATIVE) frame.putSigned(1, value);
+    else if (hasValue) frame.putUnsigned(1, value);
+    bleNotify(frame.data(), frame.size());
+    Serial.printf("📤 Sent frame: %s\n", bleCommandName(command));
+    return;
+  }
+
+  char message[BLE_TX_MAX];
+  int length;
+  if (text) length = snprintf(message, sizeof(message), "%s:%s", bleCommandName(command), text);
+  else if (hasValue) length = snprintf(message, sizeof(message), "%s:%ld", bleCommandName(command), value);
+  else length = snprintf(message, sizeof(message), "%s", bleCommandName(command));
+  if (length >= (int)sizeof(message)) length = sizeof(message) - 1;
+
+  bleNotify((const uint8_t*)message, length);
+  Serial.print("📤 Sent: ");
+  Serial.println(message);
+}
+
+void bleNotify(const uint8_t* data, size_t length) {
   if (deviceConnected && txChar) {
-    txChar->setValue(command.c_str());
-    txChar->notify();
-    Serial.println("📤 Sent: " + command);
+    txChar->setValue(data, length);
+    if (bleTxInFlight.load() == 0) lastBleTxProgress = millis();
+    bleTxInFlight++;  // before notify(), the status callback can run first
+    if (!txChar->notify()) bleTxInFlight--;
   }
 }
 
-void sendStatusToBLE() {
+// Set by the BLE callbacks, played here so the NimBLE task never touches the display
+void handleConnectionFeedback() {
+  if (connectFeedbackPending) {
+    connectFeedbackPending = false;
+    eyes.excited();
+    playTone(1200, 100);
+    playTone(1500, 100);
+  }
+  if (disconnectFeedbackPending) {
+    disconnectFeedbackPending = false;
+    bleBinaryProtocol = false;  // the next phone negotiates again
+    clearOutbound();
+    eyes.sad();
+    playTone(800, 200);
+  }
+}
+
+// === Outbound Commands ===
+// Coalesce a command under its OUTBOUND_RULES entry. PREV shares the NEXT key as
+// a negative skip. Immediate commands, and the 'text' they may carry, go straight out.
+void queueBLECommand(BleMessageType command, long value, const char* text) {
   if (!deviceConnected) return;
+  if (command == MSG_MUSIC_PREV) {
+    command = MSG_MUSIC_NEXT;
+    value = -value;
+  }
+
+  int key = outboundKey(command);
+  if (key < 0 || OUTBOUND_RULES[key].policy == SEND_IMMEDIATE) {
+    sendBLECommand(command, value, text);
+    return;
+  }
+
+  OutboundSlot& slot = outboundSlots[key];
+  if (!slot.pending) {
+    slot.pending = true;
+    slot.value = 0;
+    slot.flushAt = millis() + OUTBOUND_RULES[key].windowMs;
+  }
+  if (OUTBOUND_RULES[key].policy == SEND_LATEST) slot.value = value;
+  else slot.value += value;
 
-  // String status = "STATUS:" + String(temperature) + "," + String(humidity) + "," + (timerRunning ? "TIMER_ON" : "TIMER_OFF");
-  // sendBLECommand(status);
+  flushOutbound();  // reschedules itself for the earliest open window
 }
 
-// === BLE Callbacks ===
-class RxCallbacks : public NimBLECharacteristicCallbacks {
-  void onWrite(NimBLECharacteristic* pChar, NimBLEConnInfo& connInfo) override {
-    std::string value = pChar->getValue();
-    String data = String(value.c_str());
-    Serial.print("📩 Received: ");
-    Serial.println(data);
-
-    // Parse incoming data
-    if (data.startsWith("NOTIFICATION:")) {
-      // Format: NOTIFICATION:app|title|content
-      String payload = data.substring(13);
-      int firstPipe = payload.indexOf('|');
-      int secondPipe = payload.indexOf('|', firstPipe + 1);
-
-      if (firstPipe > 0 && secondPipe > firstPipe) {
-        String app = payload.substring(0, firstPipe);
-        String title = payload.substring(firstPipe + 1, secondPipe);
-        String content = payload.substring(secondPipe + 1);
-        addNotification(app, title, content);
+int outboundKey(BleMessageType command) {
+  for (uint8_t i = 0; i < OUTBOUND_KEYS; i++) {
+    if (OUTBOUND_RULES[i].command == command) return i;
+  }
+  return -1;
+}
+
+bool outboundPending(BleMessageType command) {
+  int key = outboundKey(command);
+  return key >= 0 && outboundSlots[key].pending;
+}
+
+// Send every key whose window has closed, as far as the in-flight cap allows
+void flushOutbound() {
+  unsigned long now = millis();
+  unsigned long next = 0;
+  bool waiting = false;
+
+  for (uint8_t i = 0; i < OUTBOUND_KEYS; i++) {
+    OutboundSlot& slot = outboundSlots[i];
+    if (!slot.pending) continue;
+
+    bool due = (long)(now - slot.flushAt) >= 0;
+    if (due && bleTxAvailable()) {
+      slot.pending = false;
+      BleMessageType command = OUTBOUND_RULES[i].command;
+      long value = slot.value;
+      if (command == MSG_MUSIC_NEXT) {
+        if (value == 0) continue;  // the skips cancelled out
+        if (value < 0) command = MSG_MUSIC_PREV;
+        value = labs(value);
       }
+      sendBLECommand(command, value, nullptr);
+      continue;
     }
-    
-   if (data.startsWith("MUSIC:")) {
-      // Format: MUSIC:song|album|artist|playing|volume|songDuration|playbackPosition
-      String payload = data.substring(6);
-
-      int firstPipe  = payload.indexOf('|');
-      int secondPipe = payload.indexOf('|', firstPipe + 1);
-      int thirdPipe  = payload.indexOf('|', secondPipe + 1);
-      int fourthPipe = payload.indexOf('|', thirdPipe + 1);
-      int fifthPipe  = payload.indexOf('|', fourthPipe + 1);
-      int sixthPipe  = payload.indexOf('|', fifthPipe + 1);
-
-      if (firstPipe > 0 && secondPipe > firstPipe && thirdPipe > secondPipe && fourthPipe > thirdPipe && fifthPipe > fourthPipe && sixthPipe > fifthPipe) {
-        currentSong      = payload.substring(0, firstPipe);
-        currentAlbum     = payload.substring(firstPipe + 1, secondPipe);
-        currentArtist    = payload.substring(secondPipe + 1, thirdPipe);
-        musicPlaying     = payload.substring(thirdPipe + 1, fourthPipe) == "true";
-        musicVolume      = payload.substring(fourthPipe + 1).toInt();
-        songDuration     = payload.substring(fifthPipe + 1).toInt();
-        playbackPosition = payload.substring(sixthPipe + 1).toInt();
-      }
+
+    unsigned long at = due ? now + BLE_TX_RETRY_MS : slot.flushAt;
+    if (!waiting || (long)(at - next) < 0) next = at;
+    waiting = true;
+  }
+
+  if (waiting) scheduleTaskAt(flushOutbound, next, 0);
+  else cancelTask(flushOutbound);
+}
+
+bool bleTxAvailable() {
+  if (bleTxInFlight.load() < BLE_TX_MAX_IN_FLIGHT) return true;
+  if (millis() - lastBleTxProgress < BLE_TX_STALL_MS) return false;
+  bleTxInFlight = 0;  // a lost status callback must not hold the queue forever
+  return true;
+}
+
+void clearOutbound() {
+  for (uint8_t i = 0; i < OUTBOUND_KEYS; i++) outboundSlots[i].pending = false;
+  cancelTask(flushOutbound);
+  bleTxInFlight = 0;
+}
+
+// === Wake Sources ===
+void IRAM_ATTR pirISR() {
+  pirChanged = true;
+  wakeLoopFromISR();
+}
+
+void IRAM_ATTR accelActivityISR() {
+  accelActivity = true;
+  wakeLoopFromISR();
+}
+
+void handleWakeSources() {
+  if (pirChanged) {
+    pirChanged = false;
+    userPresent = digitalRead(PIR_PIN);
+    lastMotionTime = millis();  // the sleep delay counts from the last edge
+    // A chosen SLEEP face stays asleep for someone sitting nearby; it wakes on touch
+    if (userPresent && isAsleep && currentState != SLEEP) wakeUp();
+  }
+
+  if (accelActivity) {
+    accelActivity = false;
+    adxl.readRegister(ADXL345_REG_INT_SOURCE);  // releases INT1 for the next edge
+    lastMotionTime = millis();
+    if (isAsleep) {
+      wakeUp();
+    } else if (currentState == IDLE) {
+      eyes.happy();  // picked up
     }
+  }
+}
 
-    if (data.startsWith("TIME:")) {
-      // Format: TIME:HH:MM:SS
-      int hh = data.substring(5, 7).toInt();
-      int mm = data.substring(8, 10).toInt();
-      int ss = data.substring(11, 13).toInt();
+// === Scheduler ===
+void scheduleTaskAt(TaskCallback callback, unsigned long when, unsigned long period) {
+  cancelTask(callback);
+  if (taskCount == MAX_SCHEDULED_TASKS) return;
+  taskHeap[taskCount] = { when, period, callback };
+  siftTaskUp(taskCount++);
+}
 
-      currentHour = hh;
-      currentMinute = mm;
-      currentSecond = ss;
+void scheduleTask(TaskCallback callback, unsigned long delay, unsigned long period) {
+  scheduleTaskAt(callback, millis() + delay, period);
+}
 
-      lastTimeSync = millis();
-      lastTick = millis();
+void cancelTask(TaskCallback callback) {
+  for (uint8_t i = 0; i < taskCount; i++) {
+    if (taskHeap[i].callback == callback) {
+      removeTaskAt(i);
+      return;
     }
-    
-    if (data.startsWith("EVENTS:")) {
-      parseEvents(data);
+  }
+}
+
+// Run every task due at 'now'. Periodic tasks keep their phase and skip periods they missed.
+void runDueTasks(unsigned long now) {
+  while (taskCount > 0 && (long)(now - taskHeap[0].deadline) >= 0) {
+    TaskCallback callback = taskHeap[0].callback;
+    unsigned long period = taskHeap[0].period;
+    if (period) {
+      taskHeap[0].deadline += ((now - taskHeap[0].deadline) / period + 1) * period;
+      siftTaskDown(0);
+    } else {
+      removeTaskAt(0);
     }
+    callback();  // free to schedule or cancel tasks, including itself
+  }
+}
+
+bool taskBefore(const ScheduledTask& a, const ScheduledTask& b) {
+  return (long)(a.deadline - b.deadline) < 0;
+}
+
+void removeTaskAt(uint8_t i) {
+  taskHeap[i] = taskHeap[--taskCount];
+  if (i == taskCount) return;
+  siftTaskUp(i);
+  siftTaskDown(i);
+}
+
+void siftTaskUp(uint8_t i) {
+  while (i > 0) {
+    uint8_t parent = (i - 1) / 2;
+    if (!taskBefore(taskHeap[i], taskHeap[parent])) break;
+    std::swap(taskHeap[i], taskHeap[parent]);
+    i = parent;
+  }
+}
+
+void siftTaskDown(uint8_t i) {
+  for (;;) {
+    uint8_t first = i;
+    uint8_t left = 2 * i + 1, right = 2 * i + 2;
+    if (left < taskCount && taskBefore(taskHeap[left], taskHeap[first])) first = left;
+    if (right < taskCount && taskBefore(taskHeap[right], taskHeap[first])) first = right;
+    if (first == i) return;
+    std::swap(taskHeap[i], taskHeap[first]);
+    i = first;
+  }
+}
+
+// === Frame Pacing ===
+void IRAM_ATTR wakeLoopFromISR() {
+  if (!wakeSignal) return;
+  BaseType_t woken = pdFALSE;
+  xSemaphoreGiveFromISR(wakeSignal, &woken);
+  if (woken) portYIELD_FROM_ISR();
+}
+
+void wakeLoop() {
+  if (wakeSignal) xSemaphoreGive(wakeSignal);
+}
+
+// Block until the next deadline or until an interrupt or BLE write gives wakeSignal
+void paceFrame(unsigned long passStart) {
+  long wait = (long)(nextWakeTime(passStart) - millis());
+  if (wait <= 0 || !wakeSignal) return;
+  xSemaphoreTake(wakeSignal, pdMS_TO_TICKS(wait));
+}
+
+// Earliest time the next pass has work to do. Reads state only, so the
+// decision can be replayed against a virtual clock.
+unsigned long nextWakeTime(unsigned long passStart) {
+  unsigned long wake = passStart + PACER_MAX_SLEEP;
+  auto at = [&wake](unsigned long when) {
+    if ((long)(when - wake) < 0) wake = when;
+  };
+
+  // Work already queued for the next pass
+  if (inputHead != inputTail) return passStart;
+  if (bleRxHead.load() != bleRxTail.load()) return passStart;
+  if (connectFeedbackPending || disconnectFeedbackPending || pirChanged || accelActivity) return passStart;
+
+  // Buttons: long press threshold and the debounce settle in checkEncoders()
+  for (uint8_t encoder = 0; encoder < 2; encoder++) {
+    const ButtonState& button = buttons[encoder];
+    if (button.pressed && !button.longPressFired) at(button.pressTime + LONG_PRESS_TIME);
+    if (passStart - button.lastEdge < BUTTON_DEBOUNCE) at(button.lastEdge + BUTTON_DEBOUNCE);
+  }
+
+  // Asleep: handleState() draws nothing but the popup, so wait for a wake source
+  if (isAsleep && currentState != NOTIFICATION_POPUP) {
+    bool buttonPending = wake != passStart + PACER_MAX_SLEEP;
+    return buttonPending ? wake : passStart + PACER_ASLEEP_MAX;
+  }
+
+  // While an expression plays only its frames are drawn; the face catches up when it ends
+  if (eyes.isAnimating()) {
+    at(passStart + EYE_FRAME_INTERVAL);
+  } else {
+    if (currentState != lastRenderedState || (renderDirty & faceDependencies(currentState))) return passStart;
+    if (renderDeadlineSet) at(renderDeadline);
+  }
+
+  if (taskCount > 0) at(taskHeap[0].deadline);
+  if (currentState != SLEEP && !userPresent) at(lastMotionTime + SLEEP_DELAY + 1);
+  if (timerRunning && selectedTimerType != STOPWATCH) at(timerStartTime + timerDuration - timerElapsed);
+
+  return wake;
+}
+
+// Scheduled every LDR_INTERVAL: map the LDR onto the contrast curve
+void updateAmbientLight() {
+  int raw = analogRead(LDR_PIN);
+  ambientLevel = ambientLevel < 0 ? raw : ambientLevel + 0.25f * (raw - ambientLevel);
+
+  int level = constrain((int)ambientLevel, 0, 4095);
+  int segment = level >> 9;
+  int contrast = AMBIENT_CONTRAST_CURVE[segment] +
+                 (AMBIENT_CONTRAST_CURVE[segment + 1] - AMBIENT_CONTRAST_CURVE[segment]) * (level & 511) / 512;
+
+  if (abs(contrast - ambientContrast) < LDR_HYSTERESIS) return;
+  ambientContrast = contrast;
+  if (!isAsleep) setDisplayContrast(ambientContrast);
+}
+
+// === BLE Receive Queue ===
+// Single producer (NimBLE task) / single consumer (loop) ring; each side only
+// advances its own index, so no lock is needed.
+bool bleRxPush(const uint8_t* data, size_t length) {
+  uint32_t head = bleRxHead.load(std::memory_order_relaxed);
+  if (head - bleRxTail.load(std::memory_order_acquire) >= BLE_RX_SLOTS) {
+    bleRxDropped++;
+    return false;
+  }
+
+  BleRxSlot& slot = bleRxSlots[head % BLE_RX_SLOTS];
+  if (length > BLE_RX_MSG_MAX) length = BLE_RX_MSG_MAX;
+  memcpy(slot.data, data, length);
+  slot.data[length] = '\0';
+  slot.length = length;
+
+  bleRxHead.store(head + 1, std::memory_order_release);
+  wakeLoop();
+  return true;
+}
+
+// Runs on the NimBLE task for every write. A partial message is abandoned when
+// its next fragment is late, out of order or belongs to another message.
+void bleRxReceive(const uint8_t* data, size_t length) {
+  if (length < BLE_FRAGMENT_HEADER || data[0] != BLE_FRAGMENT_MAGIC) {
+    bleRxPush(data, length);
+    return;
+  }
+
+  BleReassembly& a = bleRxAssembly;
+  uint8_t id = data[1], index = data[2], count = data[3];
+  uint16_t total = data[4] | data[5] << 8;
+  size_t payloadLength = length - BLE_FRAGMENT_HEADER;
+  unsigned long now = millis();
+
+  bool continues = a.active && id == a.id && index == a.nextIndex && count == a.count &&
+                   now - a.lastFragmentAt <= BLE_FRAGMENT_TIMEOUT;
+  if (a.active && !continues) {
+    a.active = false;
+    bleRxDropped++;
+  }
+  if (!continues) {
+    if (index != 0 || count == 0) return;  // the rest of a message already dropped
+    a.active = true;
+    a.id = id;
+    a.nextIndex = 0;
+    a.count = count;
+    a.total = total;
+    a.received = 0;
+  }
+
+  if (a.received < BLE_RX_MSG_MAX) {
+    // Like whole writes, messages past BLE_RX_MSG_MAX are truncated
+    memcpy(a.data + a.received, data + BLE_FRAGMENT_HEADER, min(payloadLength, (size_t)(BLE_RX_MSG_MAX - a.received)));
+  }
+  a.received = min((size_t)a.received + payloadLength, (size_t)UINT16_MAX);
+  a.lastFragmentAt = now;
+  if (++a.nextIndex < a.count) return;
+
+  a.active = false;
+  if (a.received != a.total) {
+    bleRxDropped++;
+    return;
+  }
+  bleRxPush(a.data, a.total);
+}
+
+// Drain at most BLE_RX_DRAIN_BATCH messages so a burst can't starve input and rendering
+void processBleMessages() {
+  for (int i = 0; i < BLE_RX_DRAIN_BATCH; i++) {
+    uint32_t tail = bleRxTail.load(std::memory_order_relaxed);
+    if (tail == bleRxHead.load(std::memory_order_acquire)) break;
+
+    BleRxSlot& slot = bleRxSlots[tail % BLE_RX_SLOTS];
+    handleBleMessage(slot.data, slot.length);
+    bleRxTail.store(tail + 1, std::memory_order_release);
+  }
+}
+
+struct BleMessageHandler {
+  const char* prefix;
+  void (*handle)(FieldReader& fields);
+};
+
+const BleMessageHandler bleMessageHandlers[] = {
+  { "NOTIFICATION:", handleNotificationMessage },
+  { "MUSIC:", handleMusicMessage },
+  { "MUSIC_TRACK:", handleMusicTrackMessage },
+  { "MUSIC_STATE:", handleMusicStateMessage },
+  { "MUSIC_VOLUME:", handleMusicVolumeMessage },
+  { "MUSIC_POS:", handleMusicPositionMessage },
+  { "TIME:", handleTimeMessage },
+  { "EVENTS:", handleEventsMessage },
+  { "PROTO:", handleProtocolMessage },
+  { "STATS", handleStatsMessage }
+};
+
+void handleBleMessage(const char* message, size_t length) {
+  if (length >= 3 && (uint8_t)message[0] == BLE_FRAME_MAGIC) {
+    handleBleFrame((const uint8_t*)message, length);
+    return;
+  }
+
+  Serial.print("📩 Received: ");
+  Serial.println(message);
+
+  for (const BleMessageHandler& handler : bleMessageHandlers) {
+    size_t prefixLength = strlen(handler.prefix);
+    if (length >= prefixLength && memcmp(message, handler.prefix, prefixLength) == 0) {
+      FieldReader fields(message + prefixLength, length - prefixLength);
+      handler.handle(fields);
+      return;
+    }
+  }
+}
+
+void handleNotificationMessage(FieldReader& fields) {
+  // Format: NOTIFICATION:app|title|content (content may contain '|')
+  TextView app, title, content;
+  if (!fields.next(app.data, app.length) || app.length == 0) return;
+  if (!fields.next(title.data, title.length)) return;
+  if (!fields.rest(content.data, content.length)) return;
+  applyNotification(app, title, content);
+}
+
+void handleMusicMessage(FieldReader& fields) {
+  // Format: MUSIC:song|album|artist|playing|volume|songDuration|playbackPosition
+  TextView song, album, artist, playing, position;
+  long volume, duration;
+  if (!fields.next(song.data, song.length) || song.length == 0) return;
+  if (!fields.next(album.data, album.length)) return;
+  if (!fields.next(artist.data, artist.length)) return;
+  if (!fields.next(playing.data, playing.length)) return;
+  if (!fields.nextLong(volume)) return;
+  if (!fields.nextLong(duration)) return;
+  if (!fields.rest(position.data, position.length)) return;
+
+  applyMusicUpdate(song, album, artist, FieldReader::equals(playing.data, playing.length, "true"),
+                   volume, duration, FieldReader::parseLong(position.data, position.length));
+}
+
+void handleMusicTrackMessage(FieldReader& fields) {
+  // Format: MUSIC_TRACK:song|album|artist|songDuration
+  TextView song, album, artist;
+  long duration;
+  if (!fields.next(song.data, song.length) || song.length == 0) return;
+  if (!fields.next(album.data, album.length)) return;
+  if (!fields.next(artist.data, artist.length)) return;
+  if (!fields.nextLong(duration)) return;
+  applyMusicTrack(song, album, artist, duration);
+}
+
+void handleMusicStateMessage(FieldReader& fields) {
+  // Format: MUSIC_STATE:playing|playbackPosition
+  TextView playing;
+  long position;
+  if (!fields.next(playing.data, playing.length)) return;
+  if (!fields.nextLong(position)) return;
+  applyMusicState(FieldReader::equals(playing.data, playing.length, "true"), position);
+}
+
+void handleMusicVolumeMessage(FieldReader& fields) {
+  // Format: MUSIC_VOLUME:volume
+  long volume;
+  if (!fields.nextLong(volume)) return;
+  applyMusicVolume(volume);
+}
+
+void handleMusicPositionMessage(FieldReader& fields) {
+  // Format: MUSIC_POS:playbackPosition
+  long position;
+  if (!fields.nextLong(position)) return;
+  syncPlaybackPosition(position);
+}
+
+void handleTimeMessage(FieldReader& fields) {
+  // Format: TIME:HH:MM:SS[:mmm]
+  TextView text;
+  if (!fields.rest(text.data, text.length)) return;
+
+  FieldReader parts(text.data, text.length, ':');
+  long hh, mm, ss, ms = 0;
+  if (!parts.nextLong(hh) || !parts.nextLong(mm) || !parts.nextLong(ss)) return;
+  parts.nextLong(ms);
+  applyTime(hh, mm, ss, ms);
+}
+
+void handleEventsMessage(FieldReader& fields) {
+  // Format: EVENTS:name(25m)|name(10m)|...
+  numEvents = 0;
+  selectedEventIndex = 0;
+
+  TextView token;
+  while (fields.next(token.data, token.length) && token.length > 0) {
+    const char* parenOpen = (const char*)memchr(token.data, '(', token.length);
+    const char* parenClose = (const char*)memchr(token.data, ')', token.length);
+    if (parenOpen && parenClose && parenClose > parenOpen) {
+      TextView name = { token.data, (size_t)(parenOpen - token.data) };
+      addEvent(name, FieldReader::parseLong(parenOpen + 1, parenClose - parenOpen - 1));
+    }
+  }
+  invalidateRender(DEP_EVENTS);
+}
+
+void handleProtocolMessage(FieldReader& fields) {
+  // Format: PROTO:<highest binary version the phone speaks>
+  long version;
+  if (!fields.nextLong(version)) return;
+
+  bleBinaryProtocol = version >= BLE_PROTOCOL_VERSION;
+  if (bleBinaryProtocol) {
+    char reply[16];
+    int replyLength = snprintf(reply, sizeof(reply), "PROTO:%d", BLE_PROTOCOL_VERSION);
+    bleNotify((const uint8_t*)reply, replyLength);
+  }
+}
+
+void handleStatsMessage(FieldReader& fields) {
+  // Format: STATS
+  reportStats(true);
+}
+
+void handleBleFrame(const uint8_t* frame, size_t length) {
+  uint8_t version = frame[1];
+  uint8_t type = frame[2];
+  Serial.printf("📩 Received frame type 0x%02x (%u bytes)\n", type, (unsigned)length);
+  if (version != BLE_PROTOCOL_VERSION) return;
+
+  FrameReader fields(frame + 3, length - 3);
+  uint8_t field;
+
+  switch (type) {
+    case MSG_NOTIFICATION: {
+      TextView app = { "", 0 }, title = { "", 0 }, content = { "", 0 };
+      while (fields.next(field)) {
+        if (field == 1) app = fields.textValue();
+        else if (field == 2) title = fields.textValue();
+        else if (field == 3) content = fields.textValue();
+      }
+      if (app.length > 0) applyNotification(app, title, content);
+      break;
+    }
+    case MSG_MUSIC: {
+      TextView song = { "", 0 }, album = { "", 0 }, artist = { "", 0 };
+      bool playing = false;
+      long volume = musicVolume, duration = songDuration, position = 0;
+      while (fields.next(field)) {
+        switch (field) {
+          case 1: song = fields.textValue(); break;
+          case 2: album = fields.textValue(); break;
+          case 3: artist = fields.textValue(); break;
+          case 4: playing = fields.unsignedValue() != 0; break;
+          case 5: volume = fields.unsignedValue(); break;
+          case 6: duration = fields.unsignedValue(); break;
+          case 7: position = fields.unsignedValue(); break;
+        }
+      }
+      if (song.length > 0) applyMusicUpdate(song, album, artist, playing, volume, duration, position);
+      break;
+    }
+    case MSG_MUSIC_TRACK: {
+      TextView song = { "", 0 }, album = { "", 0 }, artist = { "", 0 };
+      long duration = songDuration;
+      while (fields.next(field)) {
+        if (field == 1) song = fields.textValue();
+        else if (field == 2) album = fields.textValue();
+        else if (field == 3) artist = fields.textValue();
+        else if (field == 4) duration = fields.unsignedValue();
+      }
+      if (song.length > 0) applyMusicTrack(song, album, artist, duration);
+      break;
+    }
+    case MSG_MUSIC_STATE: {
+      bool playing = musicPlaying;
+      long position = playbackPosition;
+      while (fields.next(field)) {
+        if (field == 1) playing = fields.unsignedValue() != 0;
+        else if (field == 2) position = fields.unsignedValue();
+      }
+      applyMusicState(playing, position);
+      break;
+    }
+    case MSG_MUSIC_VOLUME:
+      while (fields.next(field)) {
+        if (field == 1) applyMusicVolume(fields.unsignedValue());
+      }
+      break;
+    case MSG_MUSIC_POSITION:
+      while (fields.next(field)) {
+        if (field == 1) syncPlaybackPosition(fields.unsignedValue());
+      }
+      break;
+    case MSG_TIME: {
+      long parts[4] = { 0, 0, 0, 0 };
+      while (fields.next(field)) {
+        if (field >= 1 && field <= 4) parts[field - 1] = fields.unsignedValue();
+      }
+      applyTime(parts[0], parts[1], parts[2], parts[3]);
+      break;
+    }
+    case MSG_EVENTS: {
+      numEvents = 0;
+      selectedEventIndex = 0;
+      TextView name = { "", 0 };
+      while (fields.next(field)) {
+        if (field == 1) name = fields.textValue();
+        else if (field == 2) addEvent(name, fields.unsignedValue());
+      }
+      invalidateRender(DEP_EVENTS);
+      break;
+    }
+  }
+}
+
+// === Message Application ===
+// Shared by the text and binary decoders
+void applyNotification(TextView app, TextView title, TextView content) {
+  char appText[NOTIF_APP_MAX], titleText[NOTIF_TITLE_MAX], contentText[NOTIF_CONTENT_MAX];
+  FieldReader::copyText(appText, sizeof(appText), app.data, app.length);
+  FieldReader::copyText(titleText, sizeof(titleText), title.data, title.length);
+  FieldReader::copyText(contentText, sizeof(contentText), content.data, content.length);
+  addNotification(appText, titleText, contentText);
+}
+
+void applyMusicUpdate(TextView song, TextView album, TextView artist, bool playing, long volume, long duration, long position) {
+  FieldReader::copyText(currentSong, sizeof(currentSong), song.data, song.length);
+  FieldReader::copyText(currentAlbum, sizeof(currentAlbum), album.data, album.length);
+  FieldReader::copyText(currentArtist, sizeof(currentArtist), artist.data, artist.length);
+  musicLayoutValid = false;
+  musicPlaying     = playing;
+  musicVolume      = volume;
+  songDuration     = duration;
+  playbackPosition = position;
+  playbackDrift    = 0;
+  lastPlaybackUpdate = millis();
+  invalidateRender(DEP_MUSIC);
+}
+
+void applyMusicTrack(TextView song, TextView album, TextView artist, long duration) {
+  FieldReader::copyText(currentSong, sizeof(currentSong), song.data, song.length);
+  FieldReader::copyText(currentAlbum, sizeof(currentAlbum), album.data, album.length);
+  FieldReader::copyText(currentArtist, sizeof(currentArtist), artist.data, artist.length);
+  musicLayoutValid = false;
+  songDuration = duration > 0 ? duration : 1;
+  playbackPosition = 0;
+  playbackDrift = 0;
+  lastPlaybackUpdate = millis();
+  invalidateRender(DEP_MUSIC);
+}
+
+void applyMusicState(bool playing, long position) {
+  if (playing && !musicPlaying) scheduleTask(advanceMusicNote, frameInterval, frameInterval);
+  musicPlaying = playing;
+  playbackPosition = constrain(position, 0L, (long)songDuration);
+  playbackDrift = 0;
+  lastPlaybackUpdate = millis();
+  invalidateRender(DEP_MUSIC);
+}
+
+void applyMusicVolume(long volume) {
+  musicVolume = constrain(volume, 0L, 100L);
+  invalidateRender(DEP_MUSIC);
+}
+
+// Small errors are slewed in by updateSeek() so the seek bar never jumps back
+void syncPlaybackPosition(long position) {
+  if (outboundPending(MSG_MUSIC_SEEK_RELATIVE)) return;  // a local seek is still on its way to the phone
+
+  long expected = playbackPosition;
+  if (musicPlaying) expected += millis() - lastPlaybackUpdate;
+
+  long error = position - expected;
+  if (!musicPlaying || labs(error) > MUSIC_DRIFT_SNAP) {
+    playbackPosition = constrain(position, 0L, (long)songDuration);
+    playbackDrift = 0;
+    lastPlaybackUpdate = millis();
+    invalidateRender(DEP_MUSIC);
+  } else {
+    playbackDrift = error;
+  }
+}
+
+void applyTime(long hh, long mm, long ss, long ms) {
+  int64_t nowUs = esp_timer_get_time();
+  int64_t synced = ((hh * 60 + mm) * 60 + ss) * 1000LL + ms;
+
+  if (clockSynced) {
+    // Error of the estimate since the drift reference, folded across midnight
+    int64_t error = (synced - clockProject(driftRefUs, driftRefMs, nowUs)) % MS_PER_DAY;
+    if (error > MS_PER_DAY / 2) error -= MS_PER_DAY;
+    if (error < -MS_PER_DAY / 2) error += MS_PER_DAY;
+    int64_t spanMs = (nowUs - driftRefUs) / 1000;
+
+    if (llabs(error) > CLOCK_STEP_THRESHOLD) {
+      clockSynced = false;  // the phone's clock jumped; measure again from here
+    } else if (spanMs >= CLOCK_DRIFT_MIN_SPAN) {
+      float residualPpm = error * 1e6f / spanMs;
+      clockDriftPpm = constrain(clockDriftPpm + CLOCK_DRIFT_GAIN * residualPpm, -CLOCK_DRIFT_MAX_PPM, CLOCK_DRIFT_MAX_PPM);
+      driftRefUs = nowUs;
+      driftRefMs = synced;
+    }
+  }
+  if (!clockSynced) {
+    driftRefUs = nowUs;
+    driftRefMs = synced;
+    clockSynced = true;
+  }
+
+  clockAnchorUs = nowUs;
+  clockAnchorMs = synced;
+  updateClock();
+}
+
+void addEvent(TextView name, long minutes) {
+  if (numEvents >= MAX_EVENTS) return;
+  FieldReader::copyText(eventNames[numEvents], EVENT_NAME_MAX, name.data, name.length);
+  eventDurations[numEvents] = minutes;
+  numEvents++;
+}
+
+// === BLE Callbacks ===
+class TxCallbacks : public NimBLECharacteristicCallbacks {
+  void onStatus(NimBLECharacteristic* pChar, int code) override {
+    // One status per notification, sent or failed: either way it left the queue
+    uint8_t count = bleTxInFlight.load();
+    while (count && !bleTxInFlight.compare_exchange_weak(count, count - 1)) {}
+    lastBleTxProgress = millis();
+  }
+} txCallbacks;
+
+class RxCallbacks : public NimBLECharacteristicCallbacks {
+  void onWrite(NimBLECharacteristic* pChar, NimBLEConnInfo& connInfo) override {
+    // Runs on the NimBLE host task: copy the write (or fragment) and return, loop() parses it
+    NimBLEAttValue value = pChar->getValue();
+    bleRxReceive(value.data(), value.size());
   }
 } rxCallbacks;
 
@@ -1734,11 +3767,9 @@ class ServerCallbacks : public NimBLEServerCallbacks {
     deviceConnected = true;
     Serial.println("✅ Connected to phone");
 
-    // Show connection feedback
-    eyes.excited();
-    playTone(1200, 100);
-    delay(50);
-    playTone(1500, 100);
+    // Connection feedback is played from loop(); tones queue back to back
+    connectFeedbackPending = true;
+    wakeLoop();
   }
 
   void onDisconnect(NimBLEServer* pServer, NimBLEConnInfo& connInfo, int reason) override {
@@ -1747,14 +3778,19 @@ class ServerCallbacks : public NimBLEServerCallbacks {
     NimBLEDevice::startAdvertising();
 
     // Show disconnection feedback
-    eyes.sad();
-    playTone(800, 200);
+    disconnectFeedbackPending = true;
+    wakeLoop();
+  }
+
+  void onMTUChange(uint16_t MTU, NimBLEConnInfo& connInfo) override {
+    Serial.printf("📏 MTU %u\n", MTU);
   }
 } serverCallbacks;
 
 void setupNimBLE() {
   // Initialize NimBLE
   NimBLEDevice::init("DeskCompanion");
+  NimBLEDevice::setMTU(BLE_PREFERRED_MTU);
 
   // Create server
   NimBLEServer* pServer = NimBLEDevice::createServer();
@@ -1773,6 +3809,7 @@ void setupNimBLE() {
   txChar = pService->createCharacteristic(
     CHARACTERISTIC_TX,
     NIMBLE_PROPERTY::NOTIFY);
+  txChar->setCallbacks(&txCallbacks);
 
   pService->start();
   pServer->start();
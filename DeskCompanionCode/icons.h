@@ -1,72 +1,95 @@
-// 'Games Face', 24x24px
-const unsigned char gamesFace [] PROGMEM = {
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0xf0, 0xff, 0x07, 0xf8, 0xff, 0x0f, 0xfc, 0xff, 0x1f, 0x9e, 0xff, 0x3c,
-  0x9e, 0xff, 0x3c, 0x06, 0x3e, 0x33, 0x06, 0x3e, 0x33, 0x9e, 0xff, 0x3c,
-  0x9e, 0xff, 0x3c, 0xfe, 0xff, 0x3f, 0xfe, 0xff, 0x3f, 0xfe, 0x80, 0x3f,
-  0x7e, 0x00, 0x3f, 0x3c, 0x00, 0x1e, 0x18, 0x00, 0x0c, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
-};
-// 'Music Face', 24x24px
-const unsigned char musicFace [] PROGMEM = {
-  0x00, 0x00, 0x00, 0x00, 0xc0, 0x01, 0x00, 0xf0, 0x03, 0x00, 0xfc, 0x03,
-  0x00, 0x3f, 0x03, 0xe0, 0x0f, 0x07, 0xf0, 0xc1, 0x07, 0x70, 0xf0, 0x0f,
-  0x60, 0x3e, 0x0e, 0xe0, 0x0f, 0x0c, 0xc0, 0x03, 0x1c, 0xc0, 0x01, 0x1e,
-  0xc0, 0x01, 0x3f, 0x80, 0x81, 0x3f, 0x80, 0xc3, 0x3f, 0xe0, 0xc3, 0x3f,
-  0xf0, 0xc7, 0x1f, 0xf8, 0x87, 0x0f, 0xf8, 0x07, 0x00, 0xf8, 0x07, 0x00,
-  0xf8, 0x03, 0x00, 0xf0, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
-};
-// 'Clock Face', 24x24px
-const unsigned char clockFace [] PROGMEM = {
-  0x00, 0x00, 0x00, 0x80, 0xff, 0x00, 0xc0, 0xff, 0x03, 0xe0, 0xff, 0x07,
-  0xf0, 0x18, 0x0f, 0x78, 0x18, 0x1e, 0x3c, 0x18, 0x3c, 0x1c, 0x18, 0x38,
-  0x1e, 0x18, 0x78, 0x0e, 0x18, 0x70, 0x0e, 0x18, 0x70, 0x0e, 0xf8, 0x73,
-  0x0e, 0xf8, 0x73, 0x0e, 0x00, 0x70, 0x0e, 0x00, 0x70, 0x1c, 0x00, 0x38,
-  0x1c, 0x00, 0x38, 0x3c, 0x00, 0x1c, 0x78, 0x00, 0x1e, 0xf0, 0x81, 0x0f,
-  0xe0, 0xff, 0x07, 0xc0, 0xff, 0x01, 0x00, 0xff, 0x00, 0x00, 0x00, 0x00
-};
-// 'Calendar Face', 24x24px
-const unsigned char eventsFace [] PROGMEM = {
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xc0, 0x80, 0x01, 0xe0, 0xc1, 0x03,
-  0xe0, 0xc1, 0x03, 0xfe, 0xff, 0x3f, 0xfe, 0xff, 0x3f, 0xfe, 0xff, 0x3f,
-  0x00, 0x00, 0x00, 0xfe, 0xff, 0x3f, 0xfe, 0xff, 0x3f, 0xfe, 0xff, 0x3f,
-  0x1e, 0x63, 0x3c, 0x1e, 0x63, 0x3c, 0xfe, 0xff, 0x3f, 0xfe, 0xff, 0x3f,
-  0x1e, 0x63, 0x3c, 0x1e, 0x63, 0x3c, 0x1e, 0x63, 0x3c, 0xfe, 0xff, 0x3f,
-  0xfe, 0xff, 0x3f, 0xfe, 0xff, 0x3f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
-};
-// 'Idle Face', 24x24px
-const unsigned char idleFace [] PROGMEM = {
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xfe, 0xc3, 0x7f, 0xff, 0xe7, 0xff,
-  0xff, 0xe7, 0xff, 0xff, 0xe7, 0xff, 0xff, 0xe7, 0xff, 0xff, 0xe7, 0xff,
-  0xff, 0xe7, 0xff, 0xff, 0xe7, 0xff, 0xff, 0xe7, 0xff, 0xff, 0xe7, 0xff,
-  0xfe, 0xc3, 0x7f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
-};
-// 'Timer Icon', 24x24px
-const unsigned char timerFace [] PROGMEM = {
-  0x00, 0x7e, 0x00, 0x00, 0x7e, 0x00, 0x00, 0x18, 0x00, 0x00, 0x3c, 0x00,
-  0x80, 0xff, 0x01, 0xe0, 0xff, 0x07, 0xf0, 0x00, 0x0f, 0x38, 0x0c, 0x1c,
-  0x18, 0x0e, 0x38, 0x1c, 0x0f, 0x38, 0x8c, 0x0f, 0x30, 0xce, 0x0f, 0x70,
-  0xce, 0x0f, 0x70, 0xce, 0x0f, 0x70, 0xce, 0x1f, 0x70, 0xce, 0x3f, 0x70,
-  0xce, 0x7f, 0x30, 0xcc, 0xff, 0x30, 0x8c, 0xff, 0x31, 0x1c, 0xff, 0x38,
-  0x38, 0x3c, 0x1c, 0x70, 0x00, 0x0e, 0xe0, 0xff, 0x07, 0x80, 0xff, 0x01
-};
-// 'Sleep Face', 24x24px
-const unsigned char sleepFace [] PROGMEM = {
-  0x00, 0x00, 0x00, 0xf8, 0x0f, 0x00, 0xf8, 0x0f, 0x00, 0x00, 0x0e, 0x00,
-  0x00, 0x0f, 0x00, 0x80, 0x07, 0x00, 0x80, 0x03, 0x00, 0xc0, 0x01, 0x00,
-  0xe0, 0x80, 0x3f, 0x70, 0x80, 0x3f, 0x38, 0x00, 0x30, 0x1c, 0x00, 0x38,
-  0xfc, 0x1f, 0x1c, 0xfc, 0x1f, 0x0e, 0x00, 0x00, 0x07, 0x00, 0x80, 0x03,
-  0x00, 0xc0, 0x7f, 0x80, 0xcf, 0x7f, 0x00, 0x0c, 0x00, 0x00, 0x06, 0x00,
-  0x00, 0x03, 0x00, 0x80, 0x01, 0x00, 0xc0, 0x0f, 0x00, 0x00, 0x00, 0x00
-};
-// 'Notification Face', 24x24px
-const unsigned char notifFace [] PROGMEM = {
-  0x00, 0x00, 0x00, 0x00, 0x18, 0x00, 0x00, 0x3c, 0x00, 0x00, 0x7e, 0x00,
-  0x80, 0xff, 0x01, 0xc0, 0xff, 0x03, 0xc0, 0xff, 0x03, 0xe0, 0xff, 0x07,
-  0xe0, 0xff, 0x07, 0xe0, 0xff, 0x07, 0xe0, 0xff, 0x07, 0xe0, 0xff, 0x07,
-  0xe0, 0xff, 0x07, 0xf0, 0xff, 0x0f, 0xf0, 0xff, 0x0f, 0xf8, 0xff, 0x1f,
-  0xf8, 0xff, 0x1f, 0xf8, 0xff, 0x1f, 0xf8, 0xff, 0x1f, 0x00, 0x00, 0x00,
-  0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0x3c, 0x00, 0x00, 0x18, 0x00
-};
\ No newline at end of file
+// 'Games Face' packed sprite, 24x24px, 1 frame: 72 bytes raw -> 45 bytes packed
+const uint8_t gamesFace_data[] PROGMEM = {
+   0xff, 0xff, 0xff, 0xaf, 0x08, 0xf2, 0x6f, 0x44, 0x42, 0x92, 0x43, 0x42,
+   0x92, 0x43, 0x26, 0x52, 0x22, 0x23, 0x26, 0x52, 0x22, 0x23, 0x42, 0x92,
+   0x43, 0x42, 0x92, 0x43, 0xf6, 0x3f, 0x63, 0x77, 0x73, 0x69, 0x64, 0x4b,
+   0x46, 0x2d, 0x2f, 0xff, 0xff, 0xff, 0xf4
+};
+const uint16_t gamesFace_frames[] PROGMEM = {
+   0x8000
+};
+const PackedSprite gamesFace = { 24, 24, 1, gamesFace_frames, gamesFace_data };
+
+// 'Music Face' packed sprite, 24x24px, 1 frame: 72 bytes raw -> 44 bytes packed
+const uint8_t musicFace_data[] PROGMEM = {
+   0xff, 0x83, 0xf4, 0x6f, 0x18, 0xe6, 0x22, 0xb7, 0x43, 0x95, 0x55, 0x93,
+   0x58, 0x92, 0x25, 0x33, 0x97, 0x62, 0xa4, 0x83, 0x93, 0x84, 0x93, 0x76,
+   0x92, 0x67, 0x93, 0x48, 0x75, 0x48, 0x67, 0x37, 0x68, 0x45, 0x78, 0xf1,
+   0x8f, 0x17, 0xf3, 0x5f, 0xff, 0xf3
+};
+const uint16_t musicFace_frames[] PROGMEM = {
+   0x8000
+};
+const PackedSprite musicFace = { 24, 24, 1, musicFace_frames, musicFace_data };
+
+// 'Clock Face' packed sprite, 24x24px, 1 frame: 72 bytes raw -> 53 bytes packed
+const uint8_t clockFace_data[] PROGMEM = {
+   0xff, 0x19, 0xec, 0xbe, 0x94, 0x32, 0x34, 0x74, 0x42, 0x44, 0x54, 0x52,
+   0x54, 0x43, 0x62, 0x63, 0x34, 0x62, 0x64, 0x23, 0x72, 0x73, 0x23, 0x72,
+   0x73, 0x23, 0x77, 0x23, 0x23, 0x77, 0x23, 0x23, 0xf1, 0x32, 0x3f, 0x13,
+   0x33, 0xe3, 0x43, 0xe3, 0x44, 0xc3, 0x64, 0xa4, 0x75, 0x65, 0x9e, 0xbb,
+   0xf0, 0x8f, 0xf2
+};
+const uint16_t clockFace_frames[] PROGMEM = {
+   0x8000
+};
+const PackedSprite clockFace = { 24, 24, 1, clockFace_frames, clockFace_data };
+
+// 'Calendar Face' packed sprite, 24x24px, 1 frame: 72 bytes raw -> 49 bytes packed
+const uint8_t eventsFace_data[] PROGMEM = {
+   0xff, 0xf9, 0x27, 0x2c, 0x45, 0x4b, 0x45, 0x47, 0xf6, 0x3f, 0x63, 0xf6,
+   0xfc, 0xf6, 0x3f, 0x63, 0xf6, 0x34, 0x32, 0x32, 0x34, 0x34, 0x32, 0x32,
+   0x34, 0x3f, 0x63, 0xf6, 0x34, 0x32, 0x32, 0x34, 0x34, 0x32, 0x32, 0x34,
+   0x34, 0x32, 0x32, 0x34, 0x3f, 0x63, 0xf6, 0x3f, 0x6f, 0xff, 0x50
+};
+const uint16_t eventsFace_frames[] PROGMEM = {
+   0x8000
+};
+const PackedSprite eventsFace = { 24, 24, 1, eventsFace_frames, eventsFace_data };
+
+// 'Idle Face' packed sprite, 24x24px, 1 frame: 72 bytes raw -> 31 bytes packed
+const uint8_t idleFace_data[] PROGMEM = {
+   0xff, 0xff, 0xff, 0xff, 0xfa, 0x94, 0x91, 0xb2, 0xf7, 0x2f, 0x72, 0xf7,
+   0x2f, 0x72, 0xf7, 0x2f, 0x72, 0xf7, 0x2f, 0x72, 0xb1, 0x94, 0x9f, 0xff,
+   0xff, 0xff, 0xff, 0xff, 0x40
+};
+const uint16_t idleFace_frames[] PROGMEM = {
+   0x8000
+};
+const PackedSprite idleFace = { 24, 24, 1, idleFace_frames, idleFace_data };
+
+// 'Timer Icon' packed sprite, 24x24px, 1 frame: 72 bytes raw -> 59 bytes packed
+const uint8_t timerFace_data[] PROGMEM = {
+   0x96, 0xf3, 0x6f, 0x52, 0xf6, 0x4f, 0x2a, 0xce, 0x94, 0x84, 0x73, 0x42,
+   0x63, 0x62, 0x43, 0x73, 0x43, 0x34, 0x73, 0x42, 0x35, 0x82, 0x33, 0x26,
+   0x83, 0x23, 0x26, 0x83, 0x23, 0x26, 0x83, 0x23, 0x27, 0x73, 0x23, 0x28,
+   0x63, 0x23, 0x29, 0x52, 0x42, 0x2a, 0x42, 0x42, 0x3a, 0x32, 0x43, 0x38,
+   0x33, 0x53, 0x44, 0x43, 0x73, 0xa3, 0x9e, 0xca, 0x70
+};
+const uint16_t timerFace_frames[] PROGMEM = {
+   0x8000
+};
+const PackedSprite timerFace = { 24, 24, 1, timerFace_frames, timerFace_data };
+
+// 'Sleep Face' packed sprite, 24x24px, 1 frame: 72 bytes raw -> 40 bytes packed
+const uint8_t sleepFace_data[] PROGMEM = {
+   0xfc, 0x9f, 0x09, 0xf6, 0x3f, 0x54, 0xf4, 0x4f, 0x53, 0xf5, 0x3f, 0x53,
+   0x77, 0x63, 0x87, 0x53, 0xe2, 0x43, 0xe3, 0x4b, 0x53, 0x5b, 0x43, 0xf5,
+   0x3f, 0x53, 0xf5, 0x98, 0x52, 0x9b, 0x2f, 0x62, 0xf6, 0x2f, 0x62, 0xf6,
+   0x6f, 0xf6
+};
+const uint16_t sleepFace_frames[] PROGMEM = {
+   0x8000
+};
+const PackedSprite sleepFace = { 24, 24, 1, sleepFace_frames, sleepFace_data };
+
+// 'Notification Face' packed sprite, 24x24px, 1 frame: 72 bytes raw -> 33 bytes packed
+const uint8_t notifFace_data[] PROGMEM = {
+   0xff, 0x52, 0xf6, 0x4f, 0x46, 0xf1, 0xad, 0xcc, 0xcb, 0xea, 0xea, 0xea,
+   0xea, 0xea, 0xe9, 0xf1, 0x8f, 0x17, 0xf3, 0x6f, 0x36, 0xf3, 0x6f, 0x3f,
+   0xf5, 0x8f, 0x18, 0xf3, 0x4f, 0x62, 0xb0
+};
+const uint16_t notifFace_frames[] PROGMEM = {
+   0x8000
+};
+const PackedSprite notifFace = { 24, 24, 1, notifFace_frames, notifFace_data };
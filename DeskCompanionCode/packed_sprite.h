@@ -0,0 +1,122 @@
+// Packed sprites - run-length coded XBM frames with a frame index
+// Data headers are exported by bitmap_to_xbm_converter.html ("Export Packed Sprite")
+//
+// Each frame is a stream of 4-bit codes, high nibble first, covering the
+// width*height pixels row by row. The colour starts at 0; code 0-14 is a run
+// of that many pixels followed by a colour toggle, code 15 is 15 pixels with
+// no toggle. A keyframe codes the pixels themselves; a delta frame codes the
+// pixels that flip relative to the previous frame.
+#pragma once
+
+#define SPRITE_KEYFRAME 0x8000      // frame index flag: frame is not a delta
+#define SPRITE_OFFSET_MASK 0x7FFF
+#define SPRITE_MAX_BYTES 128        // largest delta-decoded frame, (width + 7) / 8 * height
+
+struct PackedSprite {
+  uint8_t width;
+  uint8_t height;
+  uint8_t frameCount;
+  const uint16_t* frames;  // PROGMEM, byte offset into data per frame
+  const uint8_t* data;     // PROGMEM
+};
+
+extern U8G2_SH1106_128X64_NONAME_F_HW_I2C u8g2;
+
+// Walks the runs of one frame
+class SpriteRunReader {
+public:
+  explicit SpriteRunReader(const uint8_t* src) : src(src) {}
+
+  // Next run of 'length' pixels that are all 'value'
+  void next(uint16_t& length, uint8_t& value) {
+    length = 0;
+    uint8_t code;
+    do {
+      code = high ? pgm_read_byte(src) >> 4 : pgm_read_byte(src++) & 0x0F;
+      high = !high;
+      length += code;
+    } while (code == 15);
+    value = colour;
+    colour ^= 1;
+  }
+
+private:
+  const uint8_t* src;
+  bool high = true;
+  uint8_t colour = 0;
+};
+
+// Plot into the u8g2 frame buffer with drawXBM's colour rules
+static inline void spritePixel(uint8_t* buf, int bufWidth, int bufHeight, int x, int y, uint8_t color) {
+  if (x < 0 || y < 0 || x >= bufWidth || y >= bufHeight) return;
+  uint8_t mask = 1 << (y & 7);
+  uint8_t& b = buf[(y >> 3) * bufWidth + x];
+  if (color == 0) b &= ~mask;
+  else if (color == 1) b |= mask;
+  else b ^= mask;
+}
+
+static inline void drawSpriteRun(int x, int y, int width, uint16_t pixel, uint16_t length, bool set) {
+  u8g2_t* state = u8g2.getU8g2();
+  if (!set && state->bitmap_transparency) return;
+
+  uint8_t* buf = u8g2.getBufferPtr();
+  int bufWidth = u8g2.getBufferTileWidth() * 8;
+  int bufHeight = u8g2.getBufferTileHeight() * 8;
+  uint8_t color = set ? state->draw_color : (state->draw_color == 0 ? 1 : 0);
+
+  int row = pixel / width;
+  int col = pixel % width;
+  while (length--) {
+    spritePixel(buf, bufWidth, bufHeight, x + col, y + row, color);
+    if (++col == width) {
+      col = 0;
+      row++;
+    }
+  }
+}
+
+// Like u8g2.drawXBM, for one frame of a packed sprite
+static void drawPackedSprite(int x, int y, const PackedSprite& sprite, uint8_t frame) {
+  uint16_t pixels = sprite.width * sprite.height;
+  uint16_t entry = pgm_read_word(&sprite.frames[frame]);
+
+  if (entry & SPRITE_KEYFRAME) {
+    // Stream straight into the frame buffer
+    SpriteRunReader runs(sprite.data + (entry & SPRITE_OFFSET_MASK));
+    for (uint16_t pixel = 0; pixel < pixels;) {
+      uint16_t length;
+      uint8_t value;
+      runs.next(length, value);
+      if (length > pixels - pixel) length = pixels - pixel;
+      drawSpriteRun(x, y, sprite.width, pixel, length, value);
+      pixel += length;
+    }
+    return;
+  }
+
+  // Delta: rebuild from the nearest keyframe in a scratch XBM, then draw that
+  uint8_t key = frame;
+  while (key > 0 && !(pgm_read_word(&sprite.frames[key]) & SPRITE_KEYFRAME)) key--;
+
+  uint8_t scratch[SPRITE_MAX_BYTES];
+  uint8_t bytesPerRow = (sprite.width + 7) / 8;
+  if (bytesPerRow * sprite.height > SPRITE_MAX_BYTES) return;
+  memset(scratch, 0, sizeof(scratch));
+
+  for (uint8_t f = key; f <= frame; f++) {
+    SpriteRunReader runs(sprite.data + (pgm_read_word(&sprite.frames[f]) & SPRITE_OFFSET_MASK));
+    for (uint16_t pixel = 0; pixel < pixels;) {
+      uint16_t length;
+      uint8_t value;
+      runs.next(length, value);
+      if (length > pixels - pixel) length = pixels - pixel;
+      for (uint16_t p = pixel; value && p < pixel + length; p++) {
+        int row = p / sprite.width, col = p % sprite.width;
+        scratch[row * bytesPerRow + col / 8] ^= 1 << (col % 8);
+      }
+      pixel += length;
+    }
+  }
+  u8g2.drawXBM(x, y, sprite.width, sprite.height, scratch);
+}
@@ -1,234 +1,60 @@
 // Rotating music note animation - 16 frames
-// Each frame is 25x25 pixels
-// Memory usage: ~1600 bytes
-
-// Frame 0 - 0°
-const unsigned char musicNote_0_xbm[] PROGMEM = {
-   0x00, 0xf0, 0x1f, 0x00, 0x00, 0xf0, 0x1f, 0x00, 0x00, 0xf0, 0x1f, 0x00,
-   0x00, 0xf0, 0x1f, 0x00, 0x00, 0xf0, 0x1f, 0x00, 0x00, 0xf0, 0x1f, 0x00,
-   0x00, 0xf0, 0x1f, 0x00, 0x00, 0xf0, 0x00, 0x00, 0x00, 0xf0, 0x00, 0x00,
-   0x00, 0xf0, 0x00, 0x00, 0x00, 0xf0, 0x00, 0x00, 0x00, 0xf0, 0x00, 0x00,
-   0x00, 0xf0, 0x00, 0x00, 0x80, 0xff, 0x00, 0x00, 0xc0, 0xff, 0x00, 0x00,
-   0xe0, 0xff, 0x00, 0x00, 0xe0, 0xff, 0x00, 0x00, 0xf0, 0xff, 0x00, 0x00,
-   0xf0, 0xff, 0x00, 0x00, 0xf0, 0xff, 0x00, 0x00, 0xf0, 0xff, 0x00, 0x00,
-   0xf0, 0x7f, 0x00, 0x00, 0xe0, 0x7f, 0x00, 0x00, 0xc0, 0x3f, 0x00, 0x00,
-   0x80, 0x1f, 0x00, 0x00
-};
-
-// Frame 1 - 22.5°
-const unsigned char musicNote_1_xbm[] PROGMEM = {
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00, 0x3f, 0x00,
-   0x00, 0x00, 0xff, 0x00, 0x00, 0x80, 0xff, 0x01, 0x00, 0x80, 0xff, 0x01,
-   0x00, 0x80, 0xff, 0x00, 0x00, 0xc0, 0xff, 0x00, 0x00, 0xc0, 0xff, 0x00,
-   0x00, 0xe0, 0x73, 0x00, 0x00, 0xe0, 0x01, 0x00, 0xc0, 0xe1, 0x01, 0x00,
-   0xe0, 0xff, 0x00, 0x00, 0xf8, 0xff, 0x00, 0x00, 0xf8, 0xff, 0x00, 0x00,
-   0xfc, 0x7f, 0x00, 0x00, 0xfc, 0x7f, 0x00, 0x00, 0xfe, 0x3f, 0x00, 0x00,
-   0xfc, 0x3f, 0x00, 0x00, 0xf8, 0x3f, 0x00, 0x00, 0xfc, 0x1f, 0x00, 0x00,
-   0xf8, 0x0f, 0x00, 0x00, 0xe0, 0x07, 0x00, 0x00, 0x80, 0x01, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x00
-};
-
-// Frame 2 - 45°
-const unsigned char musicNote_2_xbm[] PROGMEM = {
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x20, 0x00, 0x00, 0x00, 0x70, 0x00, 0x00, 0x00, 0xf8, 0x00,
-   0x00, 0x00, 0xfc, 0x01, 0x00, 0x00, 0xfe, 0x01, 0x00, 0x00, 0xff, 0x01,
-   0xe0, 0x83, 0xff, 0x01, 0xf8, 0xc7, 0xff, 0x01, 0xfc, 0xef, 0xf7, 0x01,
-   0xfe, 0xff, 0xe3, 0x01, 0xfe, 0xff, 0xc1, 0x00, 0xff, 0xff, 0x00, 0x00,
-   0xfe, 0x7f, 0x00, 0x00, 0xfe, 0x3f, 0x00, 0x00, 0xfe, 0x1f, 0x00, 0x00,
-   0xfc, 0x0f, 0x00, 0x00, 0xf8, 0x07, 0x00, 0x00, 0xf0, 0x02, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x00
-};
-
-// Frame 3 - 67.5°
-const unsigned char musicNote_3_xbm[] PROGMEM = {
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-   0x20, 0x00, 0x00, 0x00, 0xf8, 0x03, 0x00, 0x01, 0xfe, 0x07, 0xe0, 0x01,
-   0xfe, 0x0f, 0xf8, 0x01, 0xfe, 0x0f, 0xff, 0x01, 0xff, 0xcf, 0xff, 0x01,
-   0xff, 0xff, 0xff, 0x01, 0xff, 0xff, 0xff, 0x01, 0xfe, 0xff, 0xf1, 0x01,
-   0xfe, 0x7f, 0xe0, 0x01, 0xfe, 0x0f, 0xe0, 0x01, 0xf8, 0x03, 0x60, 0x00,
-   0x90, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x00
-};
-
-// Frame 4 - 90°
-const unsigned char musicNote_4_xbm[] PROGMEM = {
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x00, 0xf0, 0x01, 0x00, 0x00, 0xf8, 0x07, 0x00, 0x00,
-   0xfc, 0x0f, 0x00, 0x00, 0xfe, 0x1f, 0x00, 0x00, 0xfe, 0x1f, 0x00, 0x00,
-   0xfe, 0x1f, 0x00, 0x00, 0xfe, 0x1f, 0x00, 0x00, 0xfe, 0x1f, 0x00, 0x00,
-   0xfe, 0xff, 0xff, 0x01, 0xfc, 0xff, 0xff, 0x01, 0xf8, 0xff, 0xff, 0x01,
-   0xe0, 0xff, 0xff, 0x01, 0x00, 0x00, 0xf8, 0x01, 0x00, 0x00, 0xf8, 0x01,
-   0x00, 0x00, 0xf8, 0x01, 0x00, 0x00, 0xf8, 0x01, 0x00, 0x00, 0xf8, 0x01,
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x00
-};
-
-// Frame 5 - 112.5°
-const unsigned char musicNote_5_xbm[] PROGMEM = {
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0xa0, 0x07, 0x00, 0x00,
-   0xf0, 0x1f, 0x00, 0x00, 0xf0, 0x1f, 0x00, 0x00, 0xf8, 0x3f, 0x00, 0x00,
-   0xf8, 0x7f, 0x00, 0x00, 0xfc, 0x7f, 0x00, 0x00, 0xfc, 0x7f, 0x00, 0x00,
-   0xf8, 0x3f, 0x00, 0x00, 0xf8, 0x3f, 0x00, 0x00, 0xf0, 0x3f, 0x00, 0x00,
-   0xe0, 0x3f, 0x00, 0x00, 0xc0, 0xff, 0x01, 0x00, 0x00, 0xfe, 0x07, 0x00,
-   0x00, 0xf8, 0x3f, 0x00, 0x00, 0xc0, 0xff, 0x00, 0x00, 0x00, 0xff, 0x01,
-   0x00, 0x00, 0xfe, 0x01, 0x00, 0x00, 0xfe, 0x00, 0x00, 0x00, 0xff, 0x00,
-   0x00, 0x00, 0xff, 0x00, 0x00, 0x00, 0x7f, 0x00, 0x00, 0x00, 0x7e, 0x00,
-   0x00, 0x00, 0x30, 0x00
-};
-
-// Frame 6 - 135°
-const unsigned char musicNote_6_xbm[] PROGMEM = {
-   0x00, 0x08, 0x00, 0x00, 0x00, 0x3f, 0x00, 0x00, 0x80, 0x7f, 0x00, 0x00,
-   0xc0, 0xff, 0x00, 0x00, 0xe0, 0xff, 0x00, 0x00, 0xe0, 0xff, 0x01, 0x00,
-   0xe0, 0xff, 0x01, 0x00, 0xe0, 0xff, 0x01, 0x00, 0xc0, 0xff, 0x01, 0x00,
-   0xe0, 0xff, 0x01, 0x00, 0xc0, 0xff, 0x00, 0x00, 0x80, 0x7f, 0x00, 0x00,
-   0x00, 0x3f, 0x00, 0x00, 0x00, 0x7e, 0x00, 0x00, 0x00, 0xfc, 0x00, 0x00,
-   0x00, 0xf8, 0x01, 0x00, 0x00, 0xf0, 0x03, 0x00, 0x00, 0xe0, 0x07, 0x00,
-   0x00, 0xc0, 0x0f, 0x00, 0x00, 0x80, 0x1f, 0x00, 0x00, 0xc0, 0x3f, 0x00,
-   0x00, 0xe0, 0x7f, 0x00, 0x00, 0xf0, 0x3f, 0x00, 0x00, 0xf0, 0x1f, 0x00,
-   0x00, 0xe0, 0x0f, 0x00
-};
-
-// Frame 7 - 157.5°
-const unsigned char musicNote_7_xbm[] PROGMEM = {
-   0x00, 0x70, 0x00, 0x00, 0x00, 0xfe, 0x03, 0x00, 0x00, 0xfe, 0x03, 0x00,
-   0x00, 0xff, 0x07, 0x00, 0x80, 0xff, 0x07, 0x00, 0x00, 0xff, 0x0f, 0x00,
-   0x00, 0xff, 0x07, 0x00, 0x80, 0xff, 0x07, 0x00, 0x00, 0xff, 0x07, 0x00,
-   0x00, 0xff, 0x07, 0x00, 0x00, 0xfe, 0x03, 0x00, 0x00, 0xfe, 0x01, 0x00,
-   0x00, 0x3c, 0x00, 0x00, 0x00, 0x3c, 0x00, 0x00, 0x00, 0x7c, 0x00, 0x00,
-   0x00, 0x78, 0x00, 0x00, 0x00, 0xf8, 0x00, 0x00, 0x00, 0xf0, 0x00, 0x00,
-   0x00, 0xf0, 0x00, 0x00, 0x00, 0xf0, 0x01, 0x00, 0x00, 0xf8, 0x01, 0x00,
-   0x00, 0xff, 0x03, 0x00, 0x00, 0xff, 0x03, 0x00, 0x00, 0xfe, 0x03, 0x00,
-   0x00, 0xfe, 0x07, 0x00
-};
-
-// Frame 8 - 180°
-const unsigned char musicNote_8_xbm[] PROGMEM = {
-   0x00, 0x00, 0x00, 0x00, 0x00, 0xe0, 0x07, 0x00, 0x00, 0xf0, 0x0f, 0x00,
-   0x00, 0xf8, 0x1f, 0x00, 0x00, 0xf8, 0x3f, 0x00, 0x00, 0xfc, 0x3f, 0x00,
-   0x00, 0xfc, 0x3f, 0x00, 0x00, 0xfc, 0x3f, 0x00, 0x00, 0xfc, 0x3f, 0x00,
-   0x00, 0xfc, 0x1f, 0x00, 0x00, 0xfc, 0x1f, 0x00, 0x00, 0xfc, 0x0f, 0x00,
-   0x00, 0xfc, 0x07, 0x00, 0x00, 0x3c, 0x00, 0x00, 0x00, 0x3c, 0x00, 0x00,
-   0x00, 0x3c, 0x00, 0x00, 0x00, 0x3c, 0x00, 0x00, 0x00, 0x3c, 0x00, 0x00,
-   0x00, 0x3c, 0x00, 0x00, 0xe0, 0x3f, 0x00, 0x00, 0xe0, 0x3f, 0x00, 0x00,
-   0xe0, 0x3f, 0x00, 0x00, 0xe0, 0x3f, 0x00, 0x00, 0xe0, 0x3f, 0x00, 0x00,
-   0xe0, 0x3f, 0x00, 0x00
-};
-
-// Frame 9 - 202.5°
-const unsigned char musicNote_9_xbm[] PROGMEM = {
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x06, 0x00,
-   0x00, 0x80, 0x1f, 0x00, 0x00, 0xc0, 0x7f, 0x00, 0x00, 0xe0, 0xff, 0x00,
-   0x00, 0xf0, 0x7f, 0x00, 0x00, 0xf0, 0xff, 0x00, 0x00, 0xf0, 0xff, 0x01,
-   0x00, 0xf8, 0xff, 0x00, 0x00, 0xf8, 0xff, 0x00, 0x00, 0xfc, 0x7f, 0x00,
-   0x00, 0xfc, 0x7f, 0x00, 0x00, 0xfc, 0x1f, 0x00, 0x00, 0x1e, 0x0e, 0x00,
-   0x00, 0x1e, 0x00, 0x00, 0x38, 0x1f, 0x00, 0x00, 0xfc, 0x0f, 0x00, 0x00,
-   0xfc, 0x0f, 0x00, 0x00, 0xfc, 0x07, 0x00, 0x00, 0xfe, 0x07, 0x00, 0x00,
-   0xfe, 0x07, 0x00, 0x00, 0xfc, 0x03, 0x00, 0x00, 0xf0, 0x03, 0x00, 0x00,
-   0x80, 0x01, 0x00, 0x00
-};
-
-// Frame 10 - 225°
-const unsigned char musicNote_10_xbm[] PROGMEM = {
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3d, 0x00,
-   0x00, 0x80, 0x7f, 0x00, 0x00, 0xc0, 0xff, 0x00, 0x00, 0xe0, 0xff, 0x01,
-   0x00, 0xf0, 0xff, 0x01, 0x00, 0xf8, 0xff, 0x01, 0x00, 0xfc, 0xff, 0x01,
-   0x0c, 0xfe, 0xff, 0x01, 0x1e, 0xff, 0xff, 0x01, 0xbf, 0xdf, 0xff, 0x00,
-   0xff, 0x8f, 0x7f, 0x00, 0xff, 0x07, 0x1f, 0x00, 0xff, 0x03, 0x00, 0x00,
-   0xff, 0x01, 0x00, 0x00, 0xfe, 0x00, 0x00, 0x00, 0x7c, 0x00, 0x00, 0x00,
-   0x38, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x00
-};
-
-// Frame 11 - 247.5°
-const unsigned char musicNote_11_xbm[] PROGMEM = {
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x24, 0x00, 0x18, 0x00, 0x7f, 0x00,
-   0x1e, 0xc0, 0xff, 0x01, 0x1f, 0xf8, 0xff, 0x01, 0x3f, 0xfe, 0xff, 0x01,
-   0xff, 0xff, 0xff, 0x01, 0xff, 0xff, 0xff, 0x01, 0xff, 0xcf, 0xff, 0x01,
-   0xff, 0xc3, 0xff, 0x01, 0x7f, 0xc0, 0xff, 0x01, 0x1e, 0x80, 0xff, 0x01,
-   0x02, 0x00, 0x7f, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x00
-};
-
-// Frame 12 - 270°
-const unsigned char musicNote_12_xbm[] PROGMEM = {
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7f, 0x00, 0x00, 0x00,
-   0x7f, 0x00, 0x00, 0x00, 0x7f, 0x00, 0x00, 0x00, 0x7f, 0x00, 0x00, 0x00,
-   0x7f, 0x00, 0x00, 0x00, 0xff, 0xff, 0x1f, 0x00, 0xff, 0xff, 0x7f, 0x00,
-   0xff, 0xff, 0xff, 0x00, 0xff, 0xff, 0xff, 0x01, 0x00, 0xe0, 0xff, 0x01,
-   0x00, 0xe0, 0xff, 0x01, 0x00, 0xe0, 0xff, 0x01, 0x00, 0xe0, 0xff, 0x01,
-   0x00, 0xe0, 0xff, 0x01, 0x00, 0xc0, 0xff, 0x00, 0x00, 0x80, 0x7f, 0x00,
-   0x00, 0x00, 0x3e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x00
-};
-
-// Frame 13 - 292.5°
-const unsigned char musicNote_13_xbm[] PROGMEM = {
-   0x00, 0x00, 0x00, 0x00, 0x30, 0x00, 0x00, 0x00, 0xf8, 0x01, 0x00, 0x00,
-   0xf8, 0x03, 0x00, 0x00, 0xfc, 0x03, 0x00, 0x00, 0xfc, 0x03, 0x00, 0x00,
-   0xfc, 0x01, 0x00, 0x00, 0xfe, 0x01, 0x00, 0x00, 0xfe, 0x03, 0x00, 0x00,
-   0xfc, 0x0f, 0x00, 0x00, 0xf0, 0x7f, 0x00, 0x00, 0x80, 0xff, 0x01, 0x00,
-   0x00, 0xfe, 0x0f, 0x00, 0x00, 0xf0, 0x1f, 0x00, 0x00, 0xf0, 0x3f, 0x00,
-   0x00, 0xf0, 0x7f, 0x00, 0x00, 0xf0, 0x7f, 0x00, 0x00, 0xf8, 0xff, 0x00,
-   0x00, 0xf8, 0xff, 0x00, 0x00, 0xf8, 0x7f, 0x00, 0x00, 0xf0, 0x7f, 0x00,
-   0x00, 0xe0, 0x3f, 0x00, 0x00, 0xe0, 0x3f, 0x00, 0x00, 0x80, 0x17, 0x00,
-   0x00, 0x00, 0x02, 0x00
-};
-
-// Frame 14 - 315°
-const unsigned char musicNote_14_xbm[] PROGMEM = {
-   0x80, 0x0f, 0x00, 0x00, 0xc0, 0x1f, 0x00, 0x00, 0xe0, 0x3f, 0x00, 0x00,
-   0xf0, 0x3f, 0x00, 0x00, 0xf8, 0x1f, 0x00, 0x00, 0xf0, 0x0f, 0x00, 0x00,
-   0xe0, 0x07, 0x00, 0x00, 0xc0, 0x0f, 0x00, 0x00, 0x80, 0x1f, 0x00, 0x00,
-   0x00, 0x3f, 0x00, 0x00, 0x00, 0x7e, 0x00, 0x00, 0x00, 0xfc, 0x00, 0x00,
-   0x00, 0xf8, 0x01, 0x00, 0x00, 0xf0, 0x03, 0x00, 0x00, 0xf8, 0x07, 0x00,
-   0x00, 0xfc, 0x0f, 0x00, 0x00, 0xfe, 0x1f, 0x00, 0x00, 0xfe, 0x0f, 0x00,
-   0x00, 0xfe, 0x1f, 0x00, 0x00, 0xfe, 0x1f, 0x00, 0x00, 0xfe, 0x1f, 0x00,
-   0x00, 0xfc, 0x1f, 0x00, 0x00, 0xfc, 0x0f, 0x00, 0x00, 0xf8, 0x07, 0x00,
-   0x00, 0xf0, 0x03, 0x00
-};
-
-// Frame 15 - 337.5°
-const unsigned char musicNote_15_xbm[] PROGMEM = {
-   0x00, 0xfe, 0x00, 0x00, 0x80, 0xff, 0x01, 0x00, 0x00, 0xff, 0x01, 0x00,
-   0x00, 0xff, 0x03, 0x00, 0x00, 0xff, 0x03, 0x00, 0x00, 0x7e, 0x00, 0x00,
-   0x00, 0x3e, 0x00, 0x00, 0x00, 0x3c, 0x00, 0x00, 0x00, 0x3c, 0x00, 0x00,
-   0x00, 0x7c, 0x00, 0x00, 0x00, 0x78, 0x00, 0x00, 0x00, 0xf8, 0x00, 0x00,
-   0x00, 0xf0, 0x00, 0x00, 0x00, 0xf0, 0x00, 0x00, 0x00, 0xfe, 0x01, 0x00,
-   0x00, 0xff, 0x01, 0x00, 0x80, 0xff, 0x03, 0x00, 0x80, 0xff, 0x03, 0x00,
-   0x80, 0xff, 0x07, 0x00, 0x80, 0xff, 0x03, 0x00, 0xc0, 0xff, 0x03, 0x00,
-   0x80, 0xff, 0x07, 0x00, 0x80, 0xff, 0x03, 0x00, 0x00, 0xff, 0x01, 0x00,
-   0x00, 0xff, 0x01, 0x00
-};
-
-// Array of frame pointers for easy animation
-const unsigned char* musicNote_frames[] PROGMEM = {
-   musicNote_0_xbm,
-   musicNote_1_xbm,
-   musicNote_2_xbm,
-   musicNote_3_xbm,
-   musicNote_4_xbm,
-   musicNote_5_xbm,
-   musicNote_6_xbm,
-   musicNote_7_xbm,
-   musicNote_8_xbm,
-   musicNote_9_xbm,
-   musicNote_10_xbm,
-   musicNote_11_xbm,
-   musicNote_12_xbm,
-   musicNote_13_xbm,
-   musicNote_14_xbm,
-   musicNote_15_xbm
-};
+// Each frame is 25x25 pixels, packed with bitmap_to_xbm_converter.html
+
+// 'Music Note' packed sprite, 25x25px, 16 frames: 1600 bytes raw -> 575 bytes packed
+const uint8_t musicNote_data[] PROGMEM = {
+   0xc9, 0xf1, 0x9f, 0x19, 0xf1, 0x9f, 0x19, 0xf1, 0x9f, 0x19, 0xf1, 0x4f,
+   0x64, 0xf6, 0x4f, 0x64, 0xf6, 0x4f, 0x64, 0xf1, 0x9f, 0x0a, 0xeb, 0xeb,
+   0xdc, 0xdc, 0xdc, 0xdc, 0xdb, 0xf0, 0xaf, 0x18, 0xf3, 0x6c, 0xff, 0xc2,
+   0xf7, 0x6f, 0x48, 0xf1, 0xaf, 0x0a, 0xf0, 0x9f, 0x0a, 0xf0, 0xae, 0x52,
+   0x3f, 0x04, 0xe3, 0x44, 0xdb, 0xcd, 0xcd, 0xbd, 0xcd, 0xbd, 0xdc, 0xeb,
+   0xdb, 0xf0, 0x9f, 0x36, 0xf6, 0x2f, 0xfb, 0xff, 0xff, 0xff, 0x61, 0xf8,
+   0x3f, 0x65, 0xf4, 0x7f, 0x28, 0xf1, 0x95, 0x55, 0xa3, 0x83, 0xb2, 0xa1,
+   0x61, 0x51, 0xf2, 0x34, 0x1f, 0x15, 0x21, 0xf1, 0xae, 0xbd, 0xcc, 0xea,
+   0xf1, 0x8f, 0x34, 0x11, 0xff, 0xff, 0xff, 0xfa, 0xff, 0xff, 0xff, 0xff,
+   0xff, 0x51, 0xf7, 0x7e, 0x11, 0xaa, 0x41, 0xb7, 0x61, 0xb4, 0xf6, 0x2f,
+   0xff, 0xf1, 0x1f, 0x13, 0x51, 0xe6, 0x41, 0xb9, 0x43, 0x7b, 0x26, 0x12,
+   0x1f, 0xff, 0xff, 0xff, 0xff, 0xff, 0x20, 0xff, 0xff, 0xff, 0xe5, 0xf4,
+   0x8f, 0x1a, 0xec, 0xdc, 0xdc, 0xdc, 0xdc, 0xdf, 0x92, 0xf8, 0x3f, 0x75,
+   0xf5, 0xf4, 0x6f, 0x46, 0xf4, 0x6f, 0x46, 0xf4, 0x6f, 0xff, 0xff, 0xfa,
+   0xff, 0x31, 0xf6, 0x11, 0x4f, 0x39, 0xf1, 0x9f, 0x0b, 0xec, 0xcd, 0xcd,
+   0xdb, 0xeb, 0xf0, 0xaf, 0x19, 0xf2, 0xbf, 0x2a, 0xf2, 0xbf, 0x2a, 0xf2,
+   0x9f, 0x28, 0xf2, 0x7f, 0x28, 0xf2, 0x8f, 0x27, 0xf4, 0x6f, 0x72, 0x30,
+   0xb1, 0xf6, 0x6f, 0x38, 0xf1, 0xae, 0xbe, 0xcd, 0xcd, 0xce, 0xbd, 0xce,
+   0xaf, 0x18, 0xf3, 0x6f, 0x56, 0xf5, 0x6f, 0x56, 0xf5, 0x6f, 0x56, 0xf5,
+   0x6f, 0x56, 0xf3, 0x8f, 0x1a, 0xea, 0xf0, 0x9f, 0x27, 0x50, 0xc3, 0xf4,
+   0x9f, 0x19, 0xf0, 0xbd, 0xce, 0xcd, 0xbd, 0xce, 0xbe, 0xbf, 0x09, 0xf1,
+   0x8f, 0x34, 0xf6, 0x4f, 0x65, 0xf6, 0x4f, 0x65, 0xf6, 0x4f, 0x64, 0xf6,
+   0x5f, 0x46, 0xf1, 0xaf, 0x0a, 0xf1, 0x9f, 0x1a, 0x60, 0xff, 0x86, 0xf3,
+   0x8f, 0x1a, 0xf0, 0xbd, 0xcd, 0xcd, 0xcd, 0xcd, 0xbe, 0xbe, 0xaf, 0x09,
+   0xf1, 0x4f, 0x64, 0xf6, 0x4f, 0x64, 0xf6, 0x4f, 0x64, 0xf1, 0x9f, 0x19,
+   0xf1, 0x9f, 0x19, 0xf1, 0x9f, 0x19, 0xb0, 0xff, 0xff, 0x72, 0xf6, 0x6f,
+   0x39, 0xf0, 0xbd, 0xbe, 0xcd, 0xdb, 0xdc, 0xdb, 0xdc, 0xdc, 0xbd, 0x44,
+   0x3e, 0x4f, 0x03, 0x25, 0xea, 0xf0, 0xaf, 0x09, 0xf0, 0xaf, 0x0a, 0xf1,
+   0x8f, 0x46, 0xf7, 0x2f, 0x10, 0xff, 0xff, 0xff, 0xff, 0xf6, 0x11, 0x4f,
+   0x38, 0xf1, 0xae, 0xcc, 0xdb, 0xea, 0xf0, 0x22, 0x5f, 0x11, 0x43, 0xf8,
+   0x16, 0x1a, 0x1c, 0x38, 0x2b, 0x55, 0x4a, 0xf0, 0x9f, 0x27, 0xf4, 0x5f,
+   0x63, 0xf8, 0x1f, 0xff, 0xfa, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xd1,
+   0x21, 0x62, 0xb7, 0x34, 0x9f, 0x16, 0xf5, 0x3f, 0xff, 0xff, 0x32, 0xf6,
+   0x4f, 0x37, 0xb1, 0x4a, 0xa1, 0x1e, 0x7f, 0x71, 0xff, 0xff, 0xff, 0xff,
+   0x90, 0xff, 0xff, 0xff, 0xff, 0x57, 0xf3, 0x7f, 0x37, 0xf3, 0x7f, 0x37,
+   0xf3, 0xf6, 0x4f, 0x82, 0xf9, 0x1f, 0xad, 0xcd, 0xcd, 0xcd, 0xcd, 0xce,
+   0xaf, 0x18, 0xf4, 0x5f, 0xff, 0xff, 0x30, 0xfe, 0x2f, 0x76, 0xf4, 0x7f,
+   0x28, 0xf2, 0x8f, 0x27, 0xf2, 0x8f, 0x29, 0xf2, 0xaf, 0x2b, 0xf2, 0xaf,
+   0x2b, 0xf2, 0x9f, 0x1a, 0xf0, 0xbe, 0xbd, 0xdc, 0xdc, 0xce, 0xbf, 0x09,
+   0xf1, 0x9f, 0x34, 0x11, 0xf6, 0x17, 0x75, 0xf4, 0x7f, 0x29, 0xf0, 0xae,
+   0xaf, 0x18, 0xf3, 0x6f, 0x56, 0xf5, 0x6f, 0x56, 0xf5, 0x6f, 0x56, 0xf5,
+   0x6f, 0x56, 0xf3, 0x8f, 0x1a, 0xec, 0xdb, 0xec, 0xdc, 0xdc, 0xeb, 0xea,
+   0xf1, 0x8f, 0x36, 0x70, 0x97, 0xf1, 0xaf, 0x19, 0xf1, 0xaf, 0x0a, 0xf1,
+   0x6f, 0x45, 0xf6, 0x4f, 0x64, 0xf6, 0x5f, 0x64, 0xf6, 0x5f, 0x64, 0xf6,
+   0x4f, 0x38, 0xf1, 0x9f, 0x0b, 0xeb, 0xec, 0xdb, 0xdc, 0xec, 0xdb, 0xf0,
+   0x9f, 0x19, 0x80
+};
+const uint16_t musicNote_frames[] PROGMEM = {
+   0x8000, 0x8022, 0x8043, 0x8068, 0x808b, 0x80a8, 0x80cc, 0x80ee,
+   0x8111, 0x8133, 0x8155, 0x8179, 0x8199, 0x81b7, 0x81da, 0x81fc
+};
+const PackedSprite musicNote = { 25, 25, 16, musicNote_frames, musicNote_data };
 
 // Animation helper
 extern U8G2_SH1106_128X64_NONAME_F_HW_I2C u8g2;
@@ -237,22 +63,10 @@ extern U8G2_SH1106_128X64_NONAME_F_HW_I2C u8g2;
 int currentFrame = 0;
 int noteH = 25, noteW = 25;
 
-// animation speed in ms per frame (lower = faster)
-unsigned long frameInterval = 120; 
-unsigned long lastFrameTime = 0;
-
-void drawRotatingMusicNote(int x, int y, bool playAnim) {
-   u8g2.drawXBM(
-      x, y, noteW, noteH,
-      (const unsigned char*)pgm_read_ptr(&musicNote_frames[currentFrame])
-   );
+// animation speed in ms per frame (lower = faster); the sketch's scheduler
+// advances currentFrame at this rate while music plays and freezes it otherwise
+const unsigned long frameInterval = 120;
 
-   // play animation only when music is playing, freeze otheriwse
-   if (playAnim) {
-      unsigned long now = millis();
-      if (now - lastFrameTime >= frameInterval) {
-         currentFrame = (currentFrame + 1) % MUSIC_NOTE_FRAMES;
-         lastFrameTime = now;
-      }
-   }
+void drawRotatingMusicNote(int x, int y) {
+   drawPackedSprite(x, y, musicNote, currentFrame);
 }
\ No newline at end of file
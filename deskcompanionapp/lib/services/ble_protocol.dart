@@ -0,0 +1,183 @@
+// lib/services/ble_protocol.dart
+import 'dart:convert';
+import 'dart:typed_data';
+
+// Binary framing shared with the firmware (see "Binary Protocol" in
+// DeskCompanionCode.ino). Frame: [magic][version][type] followed by fields,
+// each a tag byte (field << 3 | wire type) and a varint or length-prefixed
+// UTF-8 bytes. Text commands remain the fallback until "PROTO:1" is answered.
+class BleProtocol {
+  static const int magic = 0xDC;
+  static const int version = 1;
+
+  static const int wireVarint = 0;
+  static const int wireBytes = 2;
+
+  // Phone -> device
+  static const int notification = 0x01; // 1 app, 2 title, 3 content
+  static const int music = 0x02; // 1 song, 2 album, 3 artist, 4 playing, 5 volume, 6 duration, 7 position
+  static const int time = 0x03; // 1 hour, 2 minute, 3 second, 4 millisecond
+  static const int events = 0x04; // repeated 1 name, 2 minutes
+  static const int musicTrack = 0x05; // 1 song, 2 album, 3 artist, 4 duration
+  static const int musicState = 0x06; // 1 playing, 2 position
+  static const int musicPosition = 0x07; // 1 position
+
+  // Device -> phone
+  static const int musicPlay = 0x10;
+  static const int musicPause = 0x11;
+  static const int musicNext = 0x12; // 1 skip count, absent for a single skip
+  static const int musicPrev = 0x13; // 1 skip count, absent for a single skip
+  static const int musicVolume = 0x14; // 1 volume (also sent by the phone)
+  static const int musicSeekRelative = 0x15; // 1 milliseconds (zigzag)
+  static const int eventComplete = 0x16; // 1 event name
+
+  // Messages longer than one write are split into fragments, each prefixed with
+  // [fragmentMagic][message id][index][count][total length, 2 bytes LE]
+  static const int fragmentMagic = 0xDD;
+  static const int fragmentHeader = 6;
+  static const int maxFragments = 255;
+  static const int preferredMtu = 517;
+  static const int attOverhead = 3; // bytes of each MTU used by the ATT header
+  static const int maxWholeWrite = 512; // BLE_RX_MSG_MAX, longer single writes are truncated
+
+  static bool isFrame(List<int> data) =>
+      data.length >= 3 && data[0] == magic;
+}
+
+class BleFrameWriter {
+  final BytesBuilder _bytes = BytesBuilder();
+
+  BleFrameWriter(int type) {
+    _bytes.add([BleProtocol.magic, BleProtocol.version, type]);
+  }
+
+  void putUnsigned(int field, int value) {
+    _bytes.addByte(field << 3 | BleProtocol.wireVarint);
+    _putVarint(value);
+  }
+
+  void putSigned(int field, int value) {
+    putUnsigned(field, value >= 0 ? value << 1 : ((-value) << 1) - 1);
+  }
+
+  void putBool(int field, bool value) => putUnsigned(field, value ? 1 : 0);
+
+  void putText(int field, String text) {
+    final encoded = utf8.encode(text);
+    _bytes.addByte(field << 3 | BleProtocol.wireBytes);
+    _putVarint(encoded.length);
+    _bytes.add(encoded);
+  }
+
+  Uint8List toBytes() => _bytes.toBytes();
+
+  void _putVarint(int value) {
+    while (value >= 0x80) {
+      _bytes.addByte((value & 0x7F) | 0x80);
+      value >>= 7;
+    }
+    _bytes.addByte(value);
+  }
+}
+
+class BleFragmenter {
+  int _nextId = 0;
+
+  // Writes for [message] of at most [maxWrite] bytes each; a message that fits
+  // is returned as the only write, without a fragment header
+  List<Uint8List> split(List<int> message, int maxWrite) {
+    if (message.length <= maxWrite) return [Uint8List.fromList(message)];
+
+    final chunk = maxWrite - BleProtocol.fragmentHeader;
+    final count = (message.length + chunk - 1) ~/ chunk;
+    if (chunk <= 0 || count > BleProtocol.maxFragments || message.length > 0xFFFF) {
+      throw ArgumentError("Message of ${message.length} bytes is too long");
+    }
+
+    final id = _nextId;
+    _nextId = (_nextId + 1) & 0xFF;
+    return [
+      for (int index = 0; index < count; index++)
+        Uint8List.fromList([
+          BleProtocol.fragmentMagic,
+          id,
+          index,
+          count,
+          message.length & 0xFF,
+          message.length >> 8,
+          ...message.sublist(
+            index * chunk,
+            (index + 1) * chunk < message.length ? (index + 1) * chunk : message.length,
+          ),
+        ]),
+    ];
+  }
+}
+
+class BleFrameField {
+  final int field;
+  final int value;
+  final String text;
+
+  BleFrameField(this.field, {this.value = 0, this.text = ""});
+
+  int get signedValue => (value & 1) == 0 ? value >> 1 : -((value + 1) >> 1);
+}
+
+class BleFrameReader {
+  final int version;
+  final int type;
+  final List<BleFrameField> fields;
+
+  BleFrameReader._(this.version, this.type, this.fields);
+
+  // Returns null for malformed frames
+  static BleFrameReader? parse(List<int> data) {
+    if (!BleProtocol.isFrame(data)) return null;
+
+    final fields = <BleFrameField>[];
+    int pos = 3;
+
+    int? readVarint() {
+      int result = 0;
+      for (int shift = 0; shift < 35 && pos < data.length; shift += 7) {
+        final b = data[pos++];
+        result |= (b & 0x7F) << shift;
+        if (b & 0x80 == 0) return result;
+      }
+      return null;
+    }
+
+    while (pos < data.length) {
+      final tag = data[pos++];
+      final field = tag >> 3;
+      final wire = tag & 0x07;
+
+      if (wire == BleProtocol.wireVarint) {
+        final value = readVarint();
+        if (value == null) return null;
+        fields.add(BleFrameField(field, value: value));
+      } else if (wire == BleProtocol.wireBytes) {
+        final length = readVarint();
+        if (length == null || length > data.length - pos) return null;
+        final text = utf8.decode(
+          data.sublist(pos, pos + length),
+          allowMalformed: true,
+        );
+        pos += length;
+        fields.add(BleFrameField(field, text: text));
+      } else {
+        return null;
+      }
+    }
+
+    return BleFrameReader._(data[1], data[2], fields);
+  }
+
+  BleFrameField? field(int number) {
+    for (final f in fields) {
+      if (f.field == number) return f;
+    }
+    return null;
+  }
+}
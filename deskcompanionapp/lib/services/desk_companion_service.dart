@@ -1,6 +1,8 @@
 // lib/services/desk_companion_service.dart
 import 'dart:async';
 import 'dart:convert';
+import 'dart:math';
+import 'dart:typed_data';
 import 'package:flutter/services.dart';
 import 'package:flutter/material.dart';
 import 'package:flutter_blue_plus/flutter_blue_plus.dart';
@@ -11,6 +13,7 @@ import 'package:spotify_sdk/models/player_state.dart';
 import 'package:spotify_sdk/spotify_sdk.dart';
 import 'package:shared_preferences/shared_preferences.dart';
 import 'package:volume_controller/volume_controller.dart';
+import 'ble_protocol.dart';
 
 class DeskCompanionService extends ChangeNotifier {
   static final DeskCompanionService _instance =
@@ -29,12 +32,22 @@ class DeskCompanionService extends ChangeNotifier {
   BluetoothCharacteristic? _txCharacteristic;
   bool _isConnected = false;
   bool _isScanning = false;
+  bool _binaryProtocol = false; // set once the device answers PROTO:1
+  final BleFragmenter _fragmenter = BleFragmenter();
 
   // Service State
   bool _isInitialized = false;
   Timer? _reconnectionTimer;
   Timer? _syncTimer;
 
+  // Time sync backs off from every minute to hourly while connected; the device
+  // learns its crystal drift from successive syncs and keeps time in between
+  static const Duration _minSyncInterval = Duration(minutes: 1);
+  static const Duration _maxSyncInterval = Duration(hours: 1);
+  Duration _syncInterval = _minSyncInterval;
+  DateTime _lastTimeSync = DateTime.now();
+  Duration? _sentTimeZoneOffset;
+
   // Data Streams
   StreamSubscription<ServiceNotificationEvent>? _notificationSubscription;
   StreamSubscription<PlayerState>? _musicSubscription;
@@ -46,6 +59,14 @@ class DeskCompanionService extends ChangeNotifier {
   List<Map<String, dynamic>> _currentTasks = [];
   String _connectionLog = "";
 
+  // Music state last sent to the device, so only changes go over the air
+  String? _sentTrackKey;
+  bool? _sentPlaying;
+  int? _sentVolume;
+  int _sentPosition = 0;
+  DateTime _sentPositionAt = DateTime.now();
+  static const int _positionSyncThreshold = 1000; // ms of drift before a sync
+
   // Getters
   bool get isConnected => _isConnected;
   bool get isScanning => _isScanning;
@@ -179,14 +200,19 @@ class DeskCompanionService extends ChangeNotifier {
         if (state == BluetoothConnectionState.disconnected) {
           _log("❌ Device disconnected");
           _isConnected = false;
+          _binaryProtocol = false;
           _rxCharacteristic = null;
           _txCharacteristic = null;
           notifyListeners();
         }
       });
 
-      await device.connect(timeout: Duration(seconds: 15));
-      _log("✅ Connected to ${device.platformName}");
+      // Android negotiates the MTU here; iOS picks it on its own
+      await device.connect(
+        timeout: Duration(seconds: 15),
+        mtu: BleProtocol.preferredMtu,
+      );
+      _log("✅ Connected to ${device.platformName} (MTU ${device.mtuNow})");
 
       // Discover services
       List<BluetoothService> services = await device.discoverServices();
@@ -196,6 +222,9 @@ class DeskCompanionService extends ChangeNotifier {
       _isScanning = false;
       notifyListeners();
 
+      // Offer the binary protocol; text is used until the device answers
+      await sendToESP32("PROTO:${BleProtocol.version}");
+
       // Send initial data
       await _sendInitialData();
     } catch (e) {
@@ -221,7 +250,12 @@ class DeskCompanionService extends ChangeNotifier {
 
             // Listen for incoming data
             characteristic.lastValueStream.listen((value) {
-              _handleIncomingData(utf8.decode(value));
+              if (value.isEmpty) return;
+              if (BleProtocol.isFrame(value)) {
+                _handleIncomingFrame(value);
+              } else {
+                _handleIncomingData(utf8.decode(value, allowMalformed: true));
+              }
             });
 
             _log("📥 TX Characteristic ready");
@@ -232,7 +266,8 @@ class DeskCompanionService extends ChangeNotifier {
   }
 
   DateTime _lastSkipTime = DateTime.now();
-  final Duration _skipCooldown = Duration(milliseconds: 600);
+  // The device already coalesces a knob spin into one skip count per window
+  final Duration _skipCooldown = Duration(milliseconds: 250);
 
   void _handleIncomingData(String data) {
     _log("📩 Received: $data");
@@ -241,6 +276,12 @@ class DeskCompanionService extends ChangeNotifier {
       // Handle status updates from ESP32
     }
 
+    if (data.startsWith("PROTO:")) {
+      _binaryProtocol =
+          (int.tryParse(data.substring(6)) ?? 0) >= BleProtocol.version;
+      _log("🔧 Binary protocol ${_binaryProtocol ? 'enabled' : 'disabled'}");
+    }
+
     if (data.startsWith("MUSIC")) {
       if (data.startsWith("MUSIC_VOLUME")) {
         VolumeController.instance.setVolume(
@@ -248,10 +289,10 @@ class DeskCompanionService extends ChangeNotifier {
         );
       } else if (data == "MUSIC_PLAY" || data == "MUSIC_PAUSE") {
         playPause();
-      } else if (data == "MUSIC_NEXT") {
-        _safeSkip(skipNext);
-      } else if (data == "MUSIC_PREV") {
-        _safeSkip(skipPrevious);
+      } else if (data.startsWith("MUSIC_NEXT")) {
+        _safeSkip(skipNext, _skipCount(data));
+      } else if (data.startsWith("MUSIC_PREV")) {
+        _safeSkip(skipPrevious, _skipCount(data));
       } else if (data.startsWith("MUSIC_SEEK_RELATIVE")) {
         int millis = int.parse(data.split(":")[1]);
         seekRelative(millis);
@@ -259,11 +300,48 @@ class DeskCompanionService extends ChangeNotifier {
     }
   }
 
-  void _safeSkip(Function action) {
+  void _handleIncomingFrame(List<int> data) {
+    final frame = BleFrameReader.parse(data);
+    if (frame == null || frame.version != BleProtocol.version) {
+      _log("❌ Malformed frame (${data.length} bytes)");
+      return;
+    }
+    _log("📩 Received frame type 0x${frame.type.toRadixString(16)}");
+
+    switch (frame.type) {
+      case BleProtocol.musicVolume:
+        final volume = frame.field(1)?.value ?? 0;
+        VolumeController.instance.setVolume(volume / 100.0);
+        break;
+      case BleProtocol.musicPlay:
+      case BleProtocol.musicPause:
+        playPause();
+        break;
+      case BleProtocol.musicNext:
+        _safeSkip(skipNext, frame.field(1)?.value ?? 1);
+        break;
+      case BleProtocol.musicPrev:
+        _safeSkip(skipPrevious, frame.field(1)?.value ?? 1);
+        break;
+      case BleProtocol.musicSeekRelative:
+        seekRelative(frame.field(1)?.signedValue ?? 0);
+        break;
+    }
+  }
+
+  // "MUSIC_NEXT" is one skip, "MUSIC_NEXT:3" a coalesced run of three
+  int _skipCount(String data) {
+    final parts = data.split(":");
+    return parts.length > 1 ? int.tryParse(parts[1]) ?? 1 : 1;
+  }
+
+  Future<void> _safeSkip(Future<void> Function() action, int count) async {
     final now = DateTime.now();
     if (now.difference(_lastSkipTime) > _skipCooldown) {
-      action();
       _lastSkipTime = now;
+      for (int i = 0; i < count.clamp(1, 20); i++) {
+        await action();
+      }
     } else {
       _log("⏱ Skip ignored (cooldown active)");
     }
@@ -271,22 +349,40 @@ class DeskCompanionService extends ChangeNotifier {
 
   // === Data Sending ===
 
-  Future<void> sendToESP32(String data) async {
+  // Sends [binary] once the device has negotiated frames, [data] otherwise
+  Future<void> sendToESP32(String data, {Uint8List? binary}) async {
     if (_rxCharacteristic == null || !_isConnected) {
       _log("❌ Cannot send: Not connected");
       return;
     }
 
     try {
-      await _rxCharacteristic!.write(utf8.encode(data), withoutResponse: true);
+      if (_binaryProtocol && binary != null) {
+        await _writeMessage(binary);
+        _log("📤 Sent frame (${binary.length} bytes): $data");
+        return;
+      }
+      await _writeMessage(utf8.encode(data));
       _log("📤 Sent: $data");
     } catch (e) {
       _log("❌ Send error: $e");
     }
   }
 
+  // Fragments messages that don't fit one write at the negotiated MTU, or that
+  // are longer than the device keeps of a single write
+  Future<void> _writeMessage(List<int> message) async {
+    final maxWrite = min(_device!.mtuNow - BleProtocol.attOverhead, BleProtocol.maxWholeWrite);
+    for (final write in _fragmenter.split(message, maxWrite)) {
+      await _rxCharacteristic!.write(write, withoutResponse: true);
+    }
+  }
+
   Future<void> _sendInitialData() async {
+    _resetMusicSync();
+
     // Send current time
+    _syncInterval = _minSyncInterval;
     await _sendCurrentTime();
 
     // Send current music state if available
@@ -303,11 +399,21 @@ class DeskCompanionService extends ChangeNotifier {
 
   Future<void> _sendCurrentTime() async {
     DateTime now = DateTime.now();
+    _lastTimeSync = now;
+    _sentTimeZoneOffset = now.timeZoneOffset;
     String timeString =
-        "TIME:${now.hour.toString().padLeft(2, '0')}:${now.minute.toString().padLeft(2, '0')}:${now.second.toString().padLeft(2, '0')}";
-    await sendToESP32(timeString);
+        "TIME:${now.hour.toString().padLeft(2, '0')}:${now.minute.toString().padLeft(2, '0')}:${now.second.toString().padLeft(2, '0')}:${now.millisecond.toString().padLeft(3, '0')}";
+    final frame =
+        BleFrameWriter(BleProtocol.time)
+          ..putUnsigned(1, now.hour)
+          ..putUnsigned(2, now.minute)
+          ..putUnsigned(3, now.second)
+          ..putUnsigned(4, now.millisecond);
+    await sendToESP32(timeString, binary: frame.toBytes());
   }
 
+  // Sends only what changed since the last update: the track, play state,
+  // volume, or a position sync when the device's interpolation has drifted
   Future<void> _sendMusicUpdate(PlayerState playerState) async {
     String songName = playerState.track?.name ?? "Unknown";
     String artistName = playerState.track?.artist.name ?? "Unknown";
@@ -323,9 +429,65 @@ class DeskCompanionService extends ChangeNotifier {
     bool isPlaying = !playerState.isPaused;
     int volume = (await VolumeController.instance.getVolume() * 100).toInt();
 
-    String musicData =
-        "MUSIC:$songName|$albumName|$artistName|$isPlaying|$volume|$songDuration|$playbackPosition";
-    await sendToESP32(musicData);
+    String trackKey = "$songName|$albumName|$artistName|$songDuration";
+    bool trackChanged = trackKey != _sentTrackKey;
+
+    if (trackChanged) {
+      final frame =
+          BleFrameWriter(BleProtocol.musicTrack)
+            ..putText(1, songName)
+            ..putText(2, albumName)
+            ..putText(3, artistName)
+            ..putUnsigned(4, songDuration);
+      await sendToESP32("MUSIC_TRACK:$trackKey", binary: frame.toBytes());
+      _sentTrackKey = trackKey;
+    }
+
+    if (trackChanged || isPlaying != _sentPlaying) {
+      final frame =
+          BleFrameWriter(BleProtocol.musicState)
+            ..putBool(1, isPlaying)
+            ..putUnsigned(2, playbackPosition);
+      await sendToESP32(
+        "MUSIC_STATE:$isPlaying|$playbackPosition",
+        binary: frame.toBytes(),
+      );
+      _sentPlaying = isPlaying;
+      _markPositionSent(playbackPosition);
+    } else {
+      int expected = _sentPosition;
+      if (isPlaying) {
+        expected += DateTime.now().difference(_sentPositionAt).inMilliseconds;
+      }
+      if ((playbackPosition - expected).abs() > _positionSyncThreshold) {
+        final frame = BleFrameWriter(BleProtocol.musicPosition)
+          ..putUnsigned(1, playbackPosition);
+        await sendToESP32(
+          "MUSIC_POS:$playbackPosition",
+          binary: frame.toBytes(),
+        );
+        _markPositionSent(playbackPosition);
+      }
+    }
+
+    if (volume != _sentVolume) {
+      final frame = BleFrameWriter(BleProtocol.musicVolume)
+        ..putUnsigned(1, volume);
+      await sendToESP32("MUSIC_VOLUME:$volume", binary: frame.toBytes());
+      _sentVolume = volume;
+    }
+  }
+
+  void _markPositionSent(int position) {
+    _sentPosition = position;
+    _sentPositionAt = DateTime.now();
+  }
+
+  // Forget what the device knows so the next update is sent in full
+  void _resetMusicSync() {
+    _sentTrackKey = null;
+    _sentPlaying = null;
+    _sentVolume = null;
   }
 
   Future<void> _sendNotificationUpdate(
@@ -338,7 +500,12 @@ class DeskCompanionService extends ChangeNotifier {
     String appName = await getAppName(app);
 
     String notifData = "NOTIFICATION:$appName|$title|$content";
-    await sendToESP32(notifData);
+    final frame =
+        BleFrameWriter(BleProtocol.notification)
+          ..putText(1, appName)
+          ..putText(2, title)
+          ..putText(3, content);
+    await sendToESP32(notifData, binary: frame.toBytes());
   }
 
   Future<void> _sendTasks() async {
@@ -349,7 +516,13 @@ class DeskCompanionService extends ChangeNotifier {
           }).toList();
 
       String tasksData = "EVENTS:${taskStrings.join('|')}";
-      await sendToESP32(tasksData);
+      final frame = BleFrameWriter(BleProtocol.events);
+      for (final task in _currentTasks) {
+        frame
+          ..putText(1, "${task['name']}")
+          ..putUnsigned(2, int.tryParse("${task['duration']}") ?? 0);
+      }
+      await sendToESP32(tasksData, binary: frame.toBytes());
     }
   }
 
@@ -539,8 +712,15 @@ class DeskCompanionService extends ChangeNotifier {
 
   void _startPeriodicSync() {
     _syncTimer = Timer.periodic(Duration(minutes: 1), (timer) {
-      if (_isConnected) {
+      if (!_isConnected) return;
+
+      final now = DateTime.now();
+      if (now.timeZoneOffset != _sentTimeZoneOffset) {
+        _sendCurrentTime(); // DST or zone change: the wall clock jumped
+      } else if (now.difference(_lastTimeSync) >= _syncInterval) {
         _sendCurrentTime();
+        final next = _syncInterval * 2;
+        _syncInterval = next > _maxSyncInterval ? _maxSyncInterval : next;
       }
     });
   }
@@ -0,0 +1,232 @@
+// Text protocol decoding: the FieldReader parser against the String parser it
+// replaced (the RX callback of the baseline sketch, kept below with its state
+// as it was), over the messages in tests/corpus/protocol.txt.
+//
+//   parser_bench CORPUS [--iterations N]
+//
+// Fails when the current parser allocates while decoding. Message types the
+// baseline didn't know cost it only the String copy. The shim's String keeps its
+// text on the heap as Arduino's does, so every copy it makes is counted.
+#include "DeskCompanionCode.ino.cpp"
+#include "HostSim.h"
+#include "corpus.h"
+#include <chrono>
+#include <new>
+
+// === Allocation Counting ===
+static uint64_t allocationCount = 0;
+
+void* operator new(size_t size) {
+  allocationCount++;
+  if (void* p = malloc(size ? size : 1)) return p;
+  throw std::bad_alloc();
+}
+void* operator new[](size_t size) { return operator new(size); }
+void operator delete(void* p) noexcept { free(p); }
+void operator delete[](void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+void operator delete[](void* p, size_t) noexcept { free(p); }
+
+// === Baseline Parser ===
+namespace legacy {
+
+struct Notification {
+  String app;
+  String title;
+  String content;
+  unsigned long timestamp;
+};
+const int LEGACY_MAX_NOTIFICATIONS = 10;  // MAX_NOTIFICATIONS at the time
+Notification notifications[LEGACY_MAX_NOTIFICATIONS];
+int notificationCount = 0;
+String currentNotification = "";
+
+String currentSong = "No Music";
+String currentAlbum = "";
+String currentArtist = "";
+bool musicPlaying = false;
+int musicVolume = 50;
+int songDuration = 1000;
+int playbackPosition = 0;
+
+int currentHour = 0, currentMinute = 0, currentSecond = 0;
+unsigned long lastTimeSync = 0, lastTick = 0;
+
+String eventNames[MAX_EVENTS];
+int eventDurations[MAX_EVENTS];
+int numEvents = 0;
+int selectedEventIndex = 0;
+
+// Popup and tone left out: they are the same work in both parsers
+void addNotification(String app, String title, String content) {
+  if (notificationCount >= LEGACY_MAX_NOTIFICATIONS) {
+    for (int i = 0; i < LEGACY_MAX_NOTIFICATIONS - 1; i++) {
+      notifications[i] = notifications[i + 1];
+    }
+    notificationCount = LEGACY_MAX_NOTIFICATIONS - 1;
+  }
+
+  notifications[notificationCount] = { app, title, content, millis() };
+  notificationCount++;
+
+  currentNotification = app + ": " + title;
+}
+
+void parseEvents(String data) {
+  numEvents = 0;
+  selectedEventIndex = 0;
+
+  data.remove(0, 7);
+
+  int start = 0;
+  while (numEvents < MAX_EVENTS) {
+    int sep = data.indexOf('|', start);
+    String token = (sep == -1) ? data.substring(start) : data.substring(start, sep);
+    if (token.length() == 0) break;
+
+    int parenOpen = token.indexOf('(');
+    int parenClose = token.indexOf(')');
+    if (parenOpen != -1 && parenClose != -1) {
+      eventNames[numEvents] = token.substring(0, parenOpen);
+      String durationStr = token.substring(parenOpen + 1, parenClose);
+      durationStr.replace("m", "");
+      eventDurations[numEvents] = durationStr.toInt();
+      numEvents++;
+    }
+
+    if (sep == -1) break;
+    start = sep + 1;
+  }
+}
+
+void onWrite(const std::string& value) {
+  String data = String(value.c_str());
+  Serial.print("📩 Received: ");
+  Serial.println(data);
+
+  if (data.startsWith("NOTIFICATION:")) {
+    String payload = data.substring(13);
+    int firstPipe = payload.indexOf('|');
+    int secondPipe = payload.indexOf('|', firstPipe + 1);
+
+    if (firstPipe > 0 && secondPipe > firstPipe) {
+      String app = payload.substring(0, firstPipe);
+      String title = payload.substring(firstPipe + 1, secondPipe);
+      String content = payload.substring(secondPipe + 1);
+      addNotification(app, title, content);
+    }
+  }
+
+  if (data.startsWith("MUSIC:")) {
+    String payload = data.substring(6);
+
+    int firstPipe  = payload.indexOf('|');
+    int secondPipe = payload.indexOf('|', firstPipe + 1);
+    int thirdPipe  = payload.indexOf('|', secondPipe + 1);
+    int fourthPipe = payload.indexOf('|', thirdPipe + 1);
+    int fifthPipe  = payload.indexOf('|', fourthPipe + 1);
+    int sixthPipe  = payload.indexOf('|', fifthPipe + 1);
+
+    if (firstPipe > 0 && secondPipe > firstPipe && thirdPipe > secondPipe && fourthPipe > thirdPipe && fifthPipe > fourthPipe && sixthPipe > fifthPipe) {
+      currentSong      = payload.substring(0, firstPipe);
+      currentAlbum     = payload.substring(firstPipe + 1, secondPipe);
+      currentArtist    = payload.substring(secondPipe + 1, thirdPipe);
+      musicPlaying     = payload.substring(thirdPipe + 1, fourthPipe) == "true";
+      musicVolume      = payload.substring(fourthPipe + 1).toInt();
+      songDuration     = payload.substring(fifthPipe + 1).toInt();
+      playbackPosition = payload.substring(sixthPipe + 1).toInt();
+    }
+  }
+
+  if (data.startsWith("TIME:")) {
+    int hh = data.substring(5, 7).toInt();
+    int mm = data.substring(8, 10).toInt();
+    int ss = data.substring(11, 13).toInt();
+
+    currentHour = hh;
+    currentMinute = mm;
+    currentSecond = ss;
+
+    lastTimeSync = millis();
+    lastTick = millis();
+  }
+
+  if (data.startsWith("EVENTS:")) {
+    parseEvents(data);
+  }
+}
+
+}  // namespace legacy
+
+namespace {
+
+const int ROUNDS = 9;  // the fastest round counts
+
+struct Result {
+  double nsPerMessage;
+  double allocsPerMessage;
+};
+
+std::string kind(const std::string& message) {
+  size_t colon = message.find(':');
+  return colon == std::string::npos ? message : message.substr(0, colon);
+}
+
+// Both parsers see the message as the RX callback does: a std::string from the attribute
+template <class Parse> Result measure(const std::vector<std::string>& messages, int iterations, Parse parse) {
+  Result best = { 1e300, 0 };
+  for (int round = 0; round < ROUNDS; round++) {
+    uint64_t ns = 0, allocations = 0;
+    for (int i = 0; i < iterations; i++) {
+      for (const std::string& message : messages) {
+        hostsim::clearSerialOutput();
+        uint64_t before = allocationCount;
+        auto start = std::chrono::steady_clock::now();
+        parse(message);
+        ns += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+        allocations += allocationCount - before;
+      }
+    }
+    double count = (double)iterations * messages.size();
+    if (ns / count < best.nsPerMessage) best = { ns / count, allocations / count };
+  }
+  return best;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    fprintf(stderr, "usage: parser_bench CORPUS [--iterations N]\n");
+    return 2;
+  }
+  int iterations = 200;
+  if (argc > 3 && !strcmp(argv[2], "--iterations")) iterations = std::max(1, atoi(argv[3]));
+
+  // Grouped by message type, in corpus order
+  std::vector<std::pair<std::string, std::vector<std::string>>> groups;
+  for (const std::string& message : hosttest::loadCorpus(argv[1])) {
+    std::string name = kind(message);
+    if (name == "PROTO") continue;  // answered with a notification, not decoded into state
+    auto it = std::find_if(groups.begin(), groups.end(), [&](const auto& g) { return g.first == name; });
+    if (it == groups.end()) groups.push_back({ name, { message } });
+    else it->second.push_back(message);
+  }
+
+  printf("%-14s %12s %8s %12s %8s %8s\n", "message", "baseline ns", "allocs", "current ns", "allocs", "speedup");
+  int allocating = 0;
+  for (const auto& group : groups) {
+    Result before = measure(group.second, iterations, [](const std::string& m) { legacy::onWrite(m); });
+    Result after = measure(group.second, iterations, [](const std::string& m) { handleBleMessage(m.data(), m.size()); });
+    printf("%-14s %12.0f %8.2f %12.0f %8.2f %7.1fx%s\n", group.first.c_str(), before.nsPerMessage,
+           before.allocsPerMessage, after.nsPerMessage, after.allocsPerMessage, before.nsPerMessage / after.nsPerMessage,
+           after.allocsPerMessage > 0 ? "  ALLOCATES" : "");
+    if (after.allocsPerMessage > 0) allocating++;
+  }
+
+  if (allocating) {
+    printf("%d message type(s) allocate in the current parser\n", allocating);
+    return 1;
+  }
+  return 0;
+}
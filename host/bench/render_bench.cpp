@@ -0,0 +1,259 @@
+// Per-face render benchmark: each face draws into the frame buffer on its own,
+// without the display task, and is timed and allocation-counted per frame.
+//
+//   render_bench [--baseline FILE] [--write-baseline FILE] [--threshold 0.25]
+//                [--frames N] [--only FACE]
+//
+// With --baseline the run fails when a face is slower than its baseline by
+// more than the threshold, or allocates more per frame than it did. Speed is
+// compared as the face's cost relative to a fixed calibration frame timed in
+// the same round, so a slower or busier machine doesn't read as a regression.
+#include "DeskCompanionCode.ino.cpp"
+#include "HostSim.h"
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <new>
+#include <sstream>
+
+// === Allocation Counting ===
+static uint64_t allocationCount = 0;
+
+void* operator new(size_t size) {
+  allocationCount++;
+  if (void* p = malloc(size ? size : 1)) return p;
+  throw std::bad_alloc();
+}
+void* operator new[](size_t size) { return operator new(size); }
+void operator delete(void* p) noexcept { free(p); }
+void operator delete[](void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+void operator delete[](void* p, size_t) noexcept { free(p); }
+
+namespace {
+
+const int WARMUP_FRAMES = 20;
+const int ROUNDS = 15;             // the cheapest round counts, the others absorb host noise
+const double ALLOCATION_SLACK = 0.005;
+
+struct Face {
+  const char* name;
+  std::function<void()> setup;    // once, untimed
+  std::function<void()> prepare;  // before each frame, untimed
+  std::function<void()> render;   // the timed part
+};
+
+struct Result {
+  double nsPerFrame;
+  double allocsPerFrame;
+  double relativeCost;  // nsPerFrame over the calibration frame's
+};
+
+void sendText(const char* message) {
+  handleBleMessage(message, strlen(message));
+}
+
+void step(unsigned long ms) {
+  hostsim::advance((uint64_t)ms * 1000);
+}
+
+void showMusic(const char* message) {
+  sendText(message);
+  currentState = MUSIC;
+  selectedMusicSubstate = SEEK;
+}
+
+std::vector<Face> faces() {
+  auto none = []() {};
+  return {
+    { "idle_eyes", []() { eyes.reset(); }, none,
+      []() { eyes.applyTilt(0.1f, -0.05f); eyes.draw(); } },
+    { "eyes_happy", []() { eyes.reset(); eyes.happy(); },
+      []() {
+        step(EYE_FRAME_INTERVAL);
+        if (!eyes.update(millis())) eyes.happy();
+      },
+      []() { eyes.draw(); } },
+    { "clock", []() { sendText("TIME:09:41:00:000"); }, []() { step(250); }, displayClockFace },
+    { "music_short", []() { showMusic("MUSIC:Intro|xx|The xx|true|60|128000|5000"); }, []() { step(50); },
+      displayMusicFace },
+    { "music_long",
+      []() { showMusic("MUSIC:Midnight City (Eric Prydz Private Remix)|Hurry Up, We're Dreaming|M83|true|60|243000|15000"); },
+      []() { step(50); }, displayMusicFace },
+    { "music_utf8",
+      []() { showMusic("MUSIC:Déjà vu — Ünïcödé 日本語のタイトル|Álbum Ñandú|Sigur Rós|true|60|300000|1000"); },
+      []() { step(50); }, displayMusicFace },
+    { "notifications",
+      []() {
+        char message[128];
+        for (int i = 0; i < 12; i++) {
+          snprintf(message, sizeof(message), "NOTIFICATION:App %d|Title %d|Body text for notification number %d", i % 4, i, i);
+          sendText(message);
+        }
+        notificationScrollPos = 0;
+      },
+      none, displayNotificationsFace },
+    { "events", []() { sendText("EVENTS:Standup(15m)|Deep work(50m)|Lunch(30m)|Review(25m)"); }, none,
+      displayEventsFace },
+    { "menu", none, []() { menuSelectionIndex = (menuSelectionIndex + 1) % numFaces; }, displayMenu },
+    { "timer_running",
+      []() {
+        selectedTimerType = COUNTDOWN;
+        timerMinutes = 25;
+        startTimer();
+      },
+      []() { step(1000); }, displayTimerRunning },
+    { "pong",
+      []() {
+        initializePongGame();
+        pongGame.gameActive = true;
+        gameState = GAME_PLAYING;
+      },
+      []() {
+        step(16);
+        updatePongGame();
+        if (!pongGame.gameActive) {
+          initializePongGame();
+          pongGame.gameActive = true;
+        }
+      },
+      displayPongGame },
+  };
+}
+
+// Library drawing only, so changes to the sketch never move it
+void calibrationFrame() {
+  u8g2.clearBuffer();
+  u8g2.setFont(u8g2_font_6x10_tf);
+  u8g2.drawStr(0, 20, "Calibration 0123456789");
+  u8g2.drawDisc(64, 44, 16);
+  u8g2.drawLine(0, 0, 127, 63);
+  u8g2.drawFrame(10, 30, 108, 30);
+}
+
+uint64_t elapsedNs(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+Result run(const Face& face, int frames) {
+  face.setup();
+  for (int i = 0; i < WARMUP_FRAMES; i++) {
+    face.prepare();
+    face.render();
+  }
+
+  Result best = { 0, 0, 1e300 };
+  for (int round = 0; round < ROUNDS; round++) {
+    // Interleaved frame by frame, so both see the same host load
+    uint64_t ns = 0, calibrationNs = 0, allocations = 0;
+    for (int i = 0; i < frames; i++) {
+      auto calibrationStart = std::chrono::steady_clock::now();
+      calibrationFrame();
+      calibrationNs += elapsedNs(calibrationStart);
+
+      face.prepare();
+      uint64_t before = allocationCount;
+      auto start = std::chrono::steady_clock::now();
+      face.render();
+      ns += elapsedNs(start);
+      allocations += allocationCount - before;
+    }
+
+    double relative = (double)ns / std::max<uint64_t>(calibrationNs, 1);
+    if (relative < best.relativeCost) best = { (double)ns / frames, (double)allocations / frames, relative };
+  }
+  return best;
+}
+
+std::map<std::string, Result> readBaseline(const std::string& path) {
+  std::map<std::string, Result> baseline;
+  std::ifstream in(path);
+  if (!in) {
+    fprintf(stderr, "render_bench: cannot read %s\n", path.c_str());
+    exit(2);
+  }
+  std::string line;
+  while (std::getline(in, line)) {
+    if (line.empty() || line[0] == '#') continue;
+    std::istringstream fields(line);
+    std::string name;
+    Result r;
+    if (fields >> name >> r.nsPerFrame >> r.allocsPerFrame >> r.relativeCost) baseline[name] = r;
+  }
+  return baseline;
+}
+
+bool writeBaseline(const std::string& path, const std::vector<std::pair<std::string, Result>>& results) {
+  FILE* f = fopen(path.c_str(), "w");
+  if (!f) return false;
+  fprintf(f, "# render_bench baseline: face, ns/frame, allocations/frame, cost relative to the calibration frame\n");
+  fprintf(f, "# Regenerate with: render_bench --write-baseline host/bench/baseline.txt\n");
+  for (const auto& r : results) {
+    fprintf(f, "%-16s %10.0f %8.2f %8.3f\n", r.first.c_str(), r.second.nsPerFrame, r.second.allocsPerFrame,
+            r.second.relativeCost);
+  }
+  return fclose(f) == 0;
+}
+
+void usage() {
+  fprintf(stderr, "usage: render_bench [--baseline FILE] [--write-baseline FILE] [--threshold 0.25] [--frames N] [--only FACE]\n");
+  exit(2);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::string baselinePath, writePath, only;
+  double threshold = 0.25;
+  int frames = 500;
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if (i + 1 >= argc) usage();
+    if (arg == "--baseline") baselinePath = argv[++i];
+    else if (arg == "--write-baseline") writePath = argv[++i];
+    else if (arg == "--threshold") threshold = atof(argv[++i]);
+    else if (arg == "--frames") frames = std::max(1, atoi(argv[++i]));
+    else if (arg == "--only") only = argv[++i];
+    else usage();
+  }
+
+  std::map<std::string, Result> baseline;
+  if (!baselinePath.empty()) baseline = readBaseline(baselinePath);
+
+  // setup() minus the display task: flushDisplay() only swaps the draw buffer
+  u8g2.begin();
+  u8g2.getU8g2()->tile_buf_ptr = frameBuffers[0];
+  initializePongGame();
+
+  printf("%-16s %10s %8s %8s %8s %8s\n", "face", "ns/frame", "allocs", "cost", "baseline", "change");
+  std::vector<std::pair<std::string, Result>> results;
+  int regressions = 0;
+  for (const Face& face : faces()) {
+    if (!only.empty() && only != face.name) continue;
+    Result r = run(face, frames);
+    results.push_back({ face.name, r });
+
+    auto it = baseline.find(face.name);
+    if (it == baseline.end()) {
+      printf("%-16s %10.0f %8.2f %8.3f %8s %8s\n", face.name, r.nsPerFrame, r.allocsPerFrame, r.relativeCost, "-", "new");
+      continue;
+    }
+    const Result& base = it->second;
+    double change = r.relativeCost / base.relativeCost - 1;
+    bool slower = change > threshold;
+    bool allocates = r.allocsPerFrame > base.allocsPerFrame + ALLOCATION_SLACK;
+    printf("%-16s %10.0f %8.2f %8.3f %8.3f %+7.0f%%%s%s\n", face.name, r.nsPerFrame, r.allocsPerFrame, r.relativeCost,
+           base.relativeCost, change * 100, slower ? "  SLOWER" : "", allocates ? "  ALLOCATES" : "");
+    if (slower || allocates) regressions++;
+  }
+
+  if (!writePath.empty() && !writeBaseline(writePath, results)) {
+    fprintf(stderr, "render_bench: cannot write %s\n", writePath.c_str());
+    return 2;
+  }
+  if (regressions) {
+    printf("%d face(s) regressed past the baseline (threshold %.0f%%)\n", regressions, threshold * 100);
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,69 @@
+// Host stand-in for Adafruit_ADXL345_U. The register map is simulated in
+// peripherals.cpp: BW_RATE, FIFO_CTL stream mode, FIFO_STATUS, activity
+// detection into INT_SOURCE and the INT1 line.
+#pragma once
+#include "Arduino.h"
+
+#define ADXL345_DEFAULT_ADDRESS (0x53)
+#define ADXL345_REG_DEVID (0x00)
+#define ADXL345_REG_THRESH_TAP (0x1D)
+#define ADXL345_REG_DUR (0x21)
+#define ADXL345_REG_THRESH_ACT (0x24)
+#define ADXL345_REG_ACT_INACT_CTL (0x27)
+#define ADXL345_REG_TAP_AXES (0x2A)
+#define ADXL345_REG_BW_RATE (0x2C)
+#define ADXL345_REG_POWER_CTL (0x2D)
+#define ADXL345_REG_INT_ENABLE (0x2E)
+#define ADXL345_REG_INT_MAP (0x2F)
+#define ADXL345_REG_INT_SOURCE (0x30)
+#define ADXL345_REG_DATA_FORMAT (0x31)
+#define ADXL345_REG_DATAX0 (0x32)
+#define ADXL345_REG_FIFO_CTL (0x38)
+#define ADXL345_REG_FIFO_STATUS (0x39)
+#define ADXL345_MG2G_MULTIPLIER (0.004)
+#define SENSORS_GRAVITY_STANDARD (9.80665F)
+
+typedef enum {
+  ADXL345_RANGE_16_G = 0b11,
+  ADXL345_RANGE_8_G = 0b10,
+  ADXL345_RANGE_4_G = 0b01,
+  ADXL345_RANGE_2_G = 0b00
+} range_t;
+
+typedef enum {
+  ADXL345_DATARATE_3200_HZ = 0b1111,
+  ADXL345_DATARATE_1600_HZ = 0b1110,
+  ADXL345_DATARATE_800_HZ = 0b1101,
+  ADXL345_DATARATE_400_HZ = 0b1100,
+  ADXL345_DATARATE_200_HZ = 0b1011,
+  ADXL345_DATARATE_100_HZ = 0b1010,
+  ADXL345_DATARATE_50_HZ = 0b1001,
+  ADXL345_DATARATE_25_HZ = 0b1000,
+  ADXL345_DATARATE_12_5_HZ = 0b0111,
+  ADXL345_DATARATE_6_25HZ = 0b0110,
+} dataRate_t;
+
+struct sensors_vec_t {
+  float x, y, z;
+};
+
+struct sensors_event_t {
+  int32_t sensor_id;
+  int32_t timestamp;
+  sensors_vec_t acceleration;
+};
+
+class Adafruit_ADXL345_Unified {
+public:
+  Adafruit_ADXL345_Unified(int32_t sensorID = -1) : sensorID(sensorID) {}
+  bool begin(uint8_t addr = ADXL345_DEFAULT_ADDRESS);
+  void setRange(range_t range) { writeRegister(ADXL345_REG_DATA_FORMAT, range); }
+  void setDataRate(dataRate_t dataRate) { writeRegister(ADXL345_REG_BW_RATE, dataRate); }
+  bool getEvent(sensors_event_t* event);
+  void writeRegister(uint8_t reg, uint8_t value);
+  uint8_t readRegister(uint8_t reg);
+  int16_t read16(uint8_t reg) { return readRegister(reg) | readRegister(reg + 1) << 8; }
+
+private:
+  int32_t sensorID;
+};
@@ -0,0 +1,223 @@
+// Host stand-in for the Arduino-ESP32 core: timing runs on the hostsim virtual
+// clock, FreeRTOS calls go to its single-core scheduler, GPIO and Serial are scripted.
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <stdarg.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <string>
+
+using std::abs;
+using std::isinf;
+using std::isnan;
+using std::max;
+using std::min;
+
+#define PROGMEM
+#define IRAM_ATTR
+#define PI 3.1415926535897932384626433832795
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define INPUT_PULLUP 0x05
+#define LOW 0x0
+#define HIGH 0x1
+#define RISING 0x01
+#define FALLING 0x02
+#define CHANGE 0x03
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+inline uint8_t pgm_read_byte(const void* p) { return *(const uint8_t*)p; }
+inline uint16_t pgm_read_word(const void* p) { return *(const uint16_t*)p; }
+inline const void* pgm_read_ptr(const void* p) { return *(const void* const*)p; }
+
+// === Timing ===
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+int64_t esp_timer_get_time();
+
+// === GPIO ===
+void pinMode(uint8_t pin, uint8_t mode);
+int digitalRead(uint8_t pin);
+void digitalWrite(uint8_t pin, uint8_t level);
+uint16_t analogRead(uint8_t pin);
+inline int digitalPinToInterrupt(int pin) { return pin; }
+void attachInterrupt(uint8_t pin, void (*handler)(void), int mode);
+void detachInterrupt(uint8_t pin);
+void tone(uint8_t pin, unsigned int frequency, unsigned long duration = 0);
+void noTone(uint8_t pin);
+
+// === Math ===
+long random(long max);
+long random(long min, long max);
+void randomSeed(unsigned long seed);
+inline long map(long x, long inMin, long inMax, long outMin, long outMax) {
+  return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+uint32_t esp_random();
+
+// === String ===
+// Keeps its text in a heap buffer of its own, as the core's String does, so a
+// String on the host allocates wherever one on the device would
+class String {
+public:
+  String(const char* text = "") { assign(text ? text : "", text ? strlen(text) : 0); }
+  String(const std::string& text) { assign(text.data(), text.size()); }
+  String(char c) { assign(&c, 1); }
+  String(int value) : String(std::to_string(value)) {}
+  String(unsigned int value) : String(std::to_string(value)) {}
+  String(long value) : String(std::to_string(value)) {}
+  String(unsigned long value) : String(std::to_string(value)) {}
+  String(float value, unsigned int decimals = 2) : String(format(value, decimals)) {}
+  String(double value, unsigned int decimals = 2) : String(format(value, decimals)) {}
+  String(const String& other) { assign(other.c_str(), other.len); }
+  String(String&& other) noexcept : buf(other.buf), len(other.len), cap(other.cap) {
+    other.buf = nullptr;
+    other.len = other.cap = 0;
+  }
+  ~String() { delete[] buf; }
+  String& operator=(const String& other) {
+    if (this != &other) assign(other.c_str(), other.len);
+    return *this;
+  }
+  String& operator=(String&& other) noexcept {
+    std::swap(buf, other.buf);
+    std::swap(len, other.len);
+    std::swap(cap, other.cap);
+    return *this;
+  }
+
+  const char* c_str() const { return buf ? buf : ""; }
+  unsigned int length() const { return len; }
+  char operator[](unsigned int i) const { return i < len ? buf[i] : 0; }
+  char charAt(unsigned int i) const { return (*this)[i]; }
+
+  String& operator+=(const String& other) { append(other.c_str(), other.len); return *this; }
+  String& operator+=(const char* other) { append(other, strlen(other)); return *this; }
+  String& operator+=(char c) { append(&c, 1); return *this; }
+  // A copy of the left side, then grown by the right, as the core's StringSumHelper does
+  friend String operator+(const String& a, const String& b) { String sum(a); sum += b; return sum; }
+  friend String operator+(const String& a, const char* b) { String sum(a); sum += b; return sum; }
+  friend String operator+(const char* a, const String& b) { String sum(a); sum += b; return sum; }
+  bool operator==(const String& other) const { return len == other.len && !memcmp(c_str(), other.c_str(), len); }
+  bool operator==(const char* other) const { return !strcmp(c_str(), other); }
+  bool operator!=(const String& other) const { return !(*this == other); }
+  bool operator!=(const char* other) const { return !(*this == other); }
+
+  int indexOf(char c, unsigned int from = 0) const;
+  int indexOf(const char* text, unsigned int from = 0) const;
+  int indexOf(const String& text, unsigned int from = 0) const { return indexOf(text.c_str(), from); }
+  int lastIndexOf(char c) const { return len ? lastIndexOf(c, len - 1) : -1; }
+  int lastIndexOf(char c, unsigned int from) const;
+  String substring(unsigned int from) const { return substring(from, len); }
+  String substring(unsigned int from, unsigned int to) const;
+  bool startsWith(const String& prefix) const { return len >= prefix.len && !memcmp(c_str(), prefix.c_str(), prefix.len); }
+  bool endsWith(const String& suffix) const {
+    return len >= suffix.len && !memcmp(c_str() + len - suffix.len, suffix.c_str(), suffix.len);
+  }
+  long toInt() const { return atol(c_str()); }
+  float toFloat() const { return atof(c_str()); }
+  void trim();
+  void replace(const String& from, const String& to);
+  void remove(unsigned int index) { remove(index, len); }
+  void remove(unsigned int index, unsigned int count);
+  void toUpperCase();
+  void toLowerCase();
+
+private:
+  char* buf = nullptr;  // null until the String first holds text
+  unsigned int len = 0;
+  unsigned int cap = 0;
+
+  void reserve(unsigned int size);
+  void assign(const char* text, unsigned int size);
+  void append(const char* text, unsigned int size);
+  static std::string format(double value, unsigned int decimals);
+};
+
+// === Serial ===
+class HardwareSerial {
+public:
+  void begin(unsigned long baud) {}
+  int available();
+  int read();
+  size_t write(uint8_t c);
+  size_t write(const uint8_t* data, size_t length);
+  size_t print(const char* text);
+  size_t print(const String& text) { return print(text.c_str()); }
+  size_t print(char c);
+  size_t print(int value, int base = 10);
+  size_t print(unsigned int value, int base = 10);
+  size_t print(long value, int base = 10);
+  size_t print(unsigned long value, int base = 10);
+  size_t print(double value, int decimals = 2);
+  template <class T> size_t println(const T& value) { return print(value) + println(); }
+  size_t println() { return print("\n"); }
+  size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+};
+extern HardwareSerial Serial;
+
+// === ESP32 ===
+class EspClass {
+public:
+  uint32_t getCycleCount();
+  uint32_t getCpuFreqMHz() { return 240; }
+  uint32_t getFreeHeap();
+};
+extern EspClass ESP;
+
+// === FreeRTOS ===
+typedef void* TaskHandle_t;
+typedef void* SemaphoreHandle_t;
+typedef void (*TaskFunction_t)(void*);
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint32_t TickType_t;
+#define pdTRUE 1
+#define pdFALSE 0
+#define pdPASS pdTRUE
+#define portMAX_DELAY ((TickType_t)0xFFFFFFFF)
+#define portTICK_PERIOD_MS 1
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+#define portYIELD_FROM_ISR(...) hostYieldFromISR()
+
+// One core, so a critical section only has to keep interrupts (events) out,
+// and events never run in the middle of task code anyway
+struct portMUX_TYPE {
+  int owner;
+};
+#define portMUX_INITIALIZER_UNLOCKED { 0 }
+#define portENTER_CRITICAL(mux) (void)(mux)
+#define portEXIT_CRITICAL(mux) (void)(mux)
+#define portENTER_CRITICAL_ISR(mux) (void)(mux)
+#define portEXIT_CRITICAL_ISR(mux) (void)(mux)
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t function, const char* name, uint32_t stackDepth, void* param,
+                                   UBaseType_t priority, TaskHandle_t* handle, BaseType_t core);
+TaskHandle_t xTaskGetCurrentTaskHandle();
+TickType_t xTaskGetTickCount();
+void vTaskDelay(TickType_t ticks);
+void vTaskDelayUntil(TickType_t* previousWake, TickType_t increment);
+void taskYIELD();
+void hostYieldFromISR();
+uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t ticksToWait);
+BaseType_t xTaskNotifyGive(TaskHandle_t task);
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t* higherPriorityTaskWoken);
+
+SemaphoreHandle_t xSemaphoreCreateBinary();
+BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticksToWait);
+BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore);
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t semaphore, BaseType_t* higherPriorityTaskWoken);
+
+void setup();
+void loop();
@@ -0,0 +1,26 @@
+// Host stand-in for ESP32Encoder: the PCNT count moves only through
+// hostsim::turnEncoder()
+#pragma once
+#include "Arduino.h"
+
+namespace hostsim {
+void turnEncoder(int pinA, int detents);
+}
+
+enum class puType { up, down, none };
+
+class ESP32Encoder {
+public:
+  static puType useInternalWeakPullResistors;
+
+  void attachFullQuad(int aPin, int bPin);
+  void attachHalfQuad(int aPin, int bPin) { attachFullQuad(aPin, bPin); }
+  int64_t getCount() const { return count; }
+  void setCount(int64_t value) { count = value; }
+  void clearCount() { count = 0; }
+
+private:
+  friend void hostsim::turnEncoder(int pinA, int detents);
+  int aPin = -1;
+  int64_t count = 0;
+};
@@ -0,0 +1,111 @@
+// Control side of the host stand-ins: a virtual clock with a single-core task
+// scheduler, scripted peripherals and the simulated panel. Sketch code only
+// sees the Arduino / ESP-IDF / library headers next to this one.
+#pragma once
+#include <stdint.h>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace hostsim {
+
+const uint64_t NEVER = UINT64_MAX;
+
+// === Virtual Clock ===
+// Time only moves when every task is blocked (or on advance()), so a run is a
+// pure function of the script and the seed.
+uint64_t nowUs();
+
+// Run 'event' in interrupt context once the clock reaches timeUs. Events due at
+// the same time run in the order they were added.
+void at(uint64_t timeUs, std::function<void()> event);
+
+// Block the calling task for 'us' while other tasks and events run
+void advance(uint64_t us);
+
+// True while an event runs; interrupt-only calls are checked against it
+bool inInterrupt();
+
+// End the session: set stopRequested() and cut the loop task's current wait short
+void requestStop();
+bool stopRequested();
+
+// Seeds esp_random() / random()
+void seed(uint32_t value);
+
+// === Tasks ===
+// Priority-preemptive like FreeRTOS on one core. loop() runs as "loopTask" at
+// priority 1 on the process stack; xTaskCreatePinnedToCore tasks get their own.
+struct TaskInfo {
+  std::string name;
+  int priority;
+  bool ready;
+  uint64_t switches;  // times the task was switched in
+};
+std::vector<TaskInfo> tasks();
+
+// === GPIO ===
+// Level changes fire handlers registered with attachInterrupt()
+void setPin(int pin, int level);
+int pin(int pin);
+// Runs when the sketch calls pinMode() on 'pin', before the mode changes; for
+// devices that watch the line the sketch drives
+void onPinMode(int pin, std::function<void(int mode)> listener);
+void setAnalog(int pin, int value);
+
+// === Encoders ===
+// Full-quad detents on the ESP32Encoder attached to pinA; each detent also
+// toggles pinA so edge interrupts on it fire like on the board
+void turnEncoder(int pinA, int detents);
+
+// === Sensors ===
+void setClimate(float temperature, float humidity);  // NAN = the DHT11 doesn't answer
+void wireDht11(int pin);                              // GPIO the DHT11 data line is on
+const std::vector<uint64_t>& dhtReplies();           // times the DHT11 began answering
+void setAdxlPresent(bool present);
+void setAcceleration(float x, float y, float z);      // g; also drives the activity interrupt
+void queueAccelSamples(const std::vector<std::vector<int16_t>>& samples);  // raw x, y, z per entry
+void wireAdxlInt1(int pin);                            // GPIO the INT1 line is connected to
+
+// === Serial ===
+void serialInput(const std::string& text);
+void setSerialEcho(bool echo);
+const std::string& serialOutput();
+void clearSerialOutput();  // keeps the capacity, so later output doesn't allocate
+
+// === Buzzer ===
+struct Tone {
+  uint64_t timeUs;
+  unsigned frequency;
+  unsigned long duration;
+};
+const std::vector<Tone>& tones();
+
+// === BLE ===
+// The phone side of the link. Writes longer than the negotiated MTU are split
+// into fragments the way the app's BleFragmenter does.
+void bleConnect(uint16_t mtu = 23);
+void bleDisconnect();
+void bleSetMtu(uint16_t mtu);
+void bleWrite(const std::vector<uint8_t>& message);
+void bleWrite(const std::string& message);
+bool bleConnected();
+
+struct Notified {
+  uint64_t timeUs;
+  std::vector<uint8_t> value;
+};
+const std::vector<Notified>& bleNotifications();  // device -> phone, oldest first
+const uint64_t BLE_STATUS_DELAY_US = 7500;        // one connection interval until onStatus
+
+// === Panel ===
+// SH1106 GDDRAM as the device last wrote it, page-major like the frame buffer
+const uint8_t* panel();
+uint8_t panelContrast();
+bool panelPowerSave();
+uint64_t panelBytesWritten();
+uint64_t panelTileWrites();
+const uint64_t I2C_NS_PER_BYTE = 22500;  // 9 bit times at 400 kHz
+bool writePbm(const std::string& path, const uint8_t* pageMajor, int width = 128, int height = 64);
+
+}  // namespace hostsim
@@ -0,0 +1,107 @@
+// Host stand-in for NimBLE-Arduino: one server, callbacks run as hostsim
+// events the way the NimBLE host task would run them, and the phone side is
+// driven through hostsim::ble*().
+#pragma once
+#include "Arduino.h"
+#include <vector>
+
+class NimBLEServer;
+class NimBLECharacteristic;
+
+namespace NIMBLE_PROPERTY {
+enum {
+  READ = 0x0002,
+  WRITE_NR = 0x0004,
+  WRITE = 0x0008,
+  NOTIFY = 0x0010,
+  INDICATE = 0x0020,
+};
+}
+
+class NimBLEConnInfo {
+public:
+  uint16_t getConnHandle() const { return 1; }
+  uint16_t getMTU() const;
+};
+
+class NimBLEAttValue {
+public:
+  NimBLEAttValue() {}
+  NimBLEAttValue(const uint8_t* data, size_t length) : bytes(data, data + length) {}
+  const uint8_t* data() const { return bytes.data(); }
+  size_t size() const { return bytes.size(); }
+  size_t length() const { return bytes.size(); }
+  operator std::string() const { return std::string(bytes.begin(), bytes.end()); }
+
+private:
+  std::vector<uint8_t> bytes;
+};
+
+class NimBLECharacteristicCallbacks {
+public:
+  virtual ~NimBLECharacteristicCallbacks() {}
+  virtual void onWrite(NimBLECharacteristic* pCharacteristic, NimBLEConnInfo& connInfo) {}
+  virtual void onStatus(NimBLECharacteristic* pCharacteristic, int code) {}
+};
+
+class NimBLEServerCallbacks {
+public:
+  virtual ~NimBLEServerCallbacks() {}
+  virtual void onConnect(NimBLEServer* pServer, NimBLEConnInfo& connInfo) {}
+  virtual void onDisconnect(NimBLEServer* pServer, NimBLEConnInfo& connInfo, int reason) {}
+  virtual void onMTUChange(uint16_t MTU, NimBLEConnInfo& connInfo) {}
+};
+
+class NimBLECharacteristic {
+public:
+  NimBLECharacteristic(const char* uuid, uint32_t properties) : uuid(uuid), properties(properties) {}
+  NimBLEAttValue getValue(time_t* timestamp = nullptr) const { return value; }
+  void setValue(const uint8_t* data, size_t length) { value = NimBLEAttValue(data, length); }
+  void setValue(const char* text) { setValue((const uint8_t*)text, strlen(text)); }
+  void setCallbacks(NimBLECharacteristicCallbacks* callbacks) { this->callbacks = callbacks; }
+  NimBLECharacteristicCallbacks* getCallbacks() const { return callbacks; }
+  uint32_t getProperties() const { return properties; }
+  bool notify(bool isNotification = true);
+
+private:
+  std::string uuid;
+  uint32_t properties;
+  NimBLEAttValue value;
+  NimBLECharacteristicCallbacks* callbacks = nullptr;
+};
+
+class NimBLEService {
+public:
+  NimBLECharacteristic* createCharacteristic(const char* uuid, uint32_t properties);
+  bool start() { return true; }
+};
+
+class NimBLEServer {
+public:
+  void setCallbacks(NimBLEServerCallbacks* callbacks) { this->callbacks = callbacks; }
+  NimBLEServerCallbacks* getCallbacks() const { return callbacks; }
+  NimBLEService* createService(const char* uuid);
+  void start() {}
+  uint16_t getPeerMTU(uint16_t connHandle) const;
+
+private:
+  NimBLEServerCallbacks* callbacks = nullptr;
+};
+
+class NimBLEAdvertising {
+public:
+  void addServiceUUID(const char* uuid) {}
+  void setName(const char* name) {}
+  void enableScanResponse(bool enable) {}
+  bool start();
+};
+
+class NimBLEDevice {
+public:
+  static void init(const char* name) {}
+  static bool setMTU(uint16_t mtu);
+  static uint16_t getMTU();
+  static NimBLEServer* createServer();
+  static NimBLEAdvertising* getAdvertising();
+  static bool startAdvertising() { return getAdvertising()->start(); }
+};
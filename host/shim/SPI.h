@@ -0,0 +1,3 @@
+// The sketch includes SPI.h for U8g2; nothing here uses SPI
+#pragma once
+#include "Arduino.h"
@@ -0,0 +1,112 @@
+// Host stand-in for U8g2 with a full frame buffer in the same page-major
+// layout as the F_ constructors. Drawing follows the U8g2 colour and clipping
+// rules; fonts are a fixed 5x7 cell scaled per font, so text is the right size
+// and place but not the real glyph shapes. u8x8_DrawTile writes into the
+// simulated panel and costs I2C time on the virtual clock.
+#pragma once
+#include "Arduino.h"
+
+#define U8X8_PIN_NONE 255
+#define U8G2_DRAW_UPPER_RIGHT 0x01
+#define U8G2_DRAW_UPPER_LEFT 0x02
+#define U8G2_DRAW_LOWER_LEFT 0x04
+#define U8G2_DRAW_LOWER_RIGHT 0x08
+#define U8G2_DRAW_ALL (U8G2_DRAW_UPPER_RIGHT | U8G2_DRAW_UPPER_LEFT | U8G2_DRAW_LOWER_RIGHT | U8G2_DRAW_LOWER_LEFT)
+
+struct u8g2_cb_t {
+  int rotation;
+};
+extern const u8g2_cb_t u8g2_cb_r0;
+#define U8G2_R0 (&u8g2_cb_r0)
+
+struct u8x8_t {
+  uint8_t tileWidth;
+  uint8_t tileHeight;
+};
+
+struct u8g2_t {
+  u8x8_t u8x8;  // first, as in U8g2, so the two pointers convert
+  uint8_t* tile_buf_ptr;
+  uint8_t draw_color;
+  uint8_t bitmap_transparency;
+  uint8_t font_mode;  // 0 solid, 1 transparent
+  const uint8_t* font;
+};
+
+// Font descriptors: { advance, scale, bold }
+extern const uint8_t u8g2_font_4x6_tf[];
+extern const uint8_t u8g2_font_6x10_tf[];
+extern const uint8_t u8g2_font_6x12_tf[];
+extern const uint8_t u8g2_font_7x13_tf[];
+extern const uint8_t u8g2_font_7x13B_tf[];
+extern const uint8_t u8g2_font_ncenB10_tf[];
+extern const uint8_t u8g2_font_courB24_tn[];
+extern const uint8_t u8g2_font_logisoso18_tr[];
+extern const uint8_t u8g2_font_logisoso24_tr[];
+
+uint8_t u8x8_DrawTile(u8x8_t* u8x8, uint8_t x, uint8_t y, uint8_t count, uint8_t* tiles);
+void u8x8_SetContrast(u8x8_t* u8x8, uint8_t value);
+void u8x8_SetPowerSave(u8x8_t* u8x8, uint8_t isEnable);
+
+class U8G2 {
+public:
+  bool begin();
+  void clearBuffer();
+  void sendBuffer();
+  void clearDisplay() { clearBuffer(); sendBuffer(); }
+  void setContrast(uint8_t value) { u8x8_SetContrast(getU8x8(), value); }
+  void setPowerSave(uint8_t isEnable) { u8x8_SetPowerSave(getU8x8(), isEnable); }
+
+  void setDrawColor(uint8_t color) { u.draw_color = color; }
+  void setBitmapMode(uint8_t transparent) { u.bitmap_transparency = transparent; }
+  void setFont(const uint8_t* font) { u.font = font; }
+  void setFontMode(uint8_t transparent) { u.font_mode = transparent; }
+  int8_t getAscent();
+  int8_t getDescent();
+  int8_t getMaxCharHeight() { return getAscent() - getDescent(); }
+
+  void drawPixel(int x, int y);
+  void drawHLine(int x, int y, int w);
+  void drawVLine(int x, int y, int h);
+  void drawLine(int x1, int y1, int x2, int y2);
+  void drawBox(int x, int y, int w, int h);
+  void drawFrame(int x, int y, int w, int h);
+  void drawRBox(int x, int y, int w, int h, int r);
+  void drawRFrame(int x, int y, int w, int h, int r);
+  void drawCircle(int x0, int y0, int rad, uint8_t option = U8G2_DRAW_ALL);
+  void drawDisc(int x0, int y0, int rad, uint8_t option = U8G2_DRAW_ALL);
+  void drawTriangle(int x0, int y0, int x1, int y1, int x2, int y2);
+  void drawArc(int x0, int y0, int rad, uint8_t start, uint8_t end);
+  void drawXBM(int x, int y, int w, int h, const uint8_t* bitmap);
+  void drawXBMP(int x, int y, int w, int h, const uint8_t* bitmap) { drawXBM(x, y, w, h, bitmap); }
+
+  int drawStr(int x, int y, const char* text);
+  int drawUTF8(int x, int y, const char* text);
+  int getStrWidth(const char* text);
+  int getUTF8Width(const char* text);
+
+  uint8_t* getBufferPtr() { return u.tile_buf_ptr; }
+  uint8_t getBufferTileWidth() { return u.u8x8.tileWidth; }
+  uint8_t getBufferTileHeight() { return u.u8x8.tileHeight; }
+  u8g2_t* getU8g2() { return &u; }
+  u8x8_t* getU8x8() { return &u.u8x8; }
+
+protected:
+  U8G2();
+
+  u8g2_t u;
+  uint8_t buffer[128 * 8];
+
+private:
+  void pixel(int x, int y, uint8_t color);
+  void span(int x1, int x2, int y);
+  void circlePoints(int x0, int y0, int x, int y, uint8_t option, bool fill);
+  int drawGlyph(int x, int y, uint32_t code);
+  int drawText(int x, int y, const char* text, bool utf8);
+};
+
+class U8G2_SH1106_128X64_NONAME_F_HW_I2C : public U8G2 {
+public:
+  U8G2_SH1106_128X64_NONAME_F_HW_I2C(const u8g2_cb_t* rotation, uint8_t reset = U8X8_PIN_NONE,
+                                     uint8_t clock = U8X8_PIN_NONE, uint8_t data = U8X8_PIN_NONE) {}
+};
@@ -0,0 +1,25 @@
+// Host stand-in for the ESP32 Wire library. Only the ADXL345 answers on the
+// bus; the display goes through u8x8_DrawTile instead.
+#pragma once
+#include "Arduino.h"
+
+class TwoWire {
+public:
+  bool begin(int sda = -1, int scl = -1, uint32_t frequency = 0) { return true; }
+  void setClock(uint32_t frequency) {}
+  void beginTransmission(uint8_t address);
+  size_t write(uint8_t data);
+  uint8_t endTransmission(bool sendStop = true);
+  uint8_t requestFrom(uint8_t address, uint8_t quantity, bool sendStop = true);
+  int available();
+  int read();
+
+private:
+  uint8_t address = 0;
+  uint8_t txBuffer[32];
+  uint8_t txLength = 0;
+  uint8_t rxBuffer[32];
+  uint8_t rxLength = 0;
+  uint8_t rxIndex = 0;
+};
+extern TwoWire Wire;
@@ -0,0 +1,267 @@
+// GPIO, Serial, buzzer, random numbers and String helpers for the host build
+#include "Arduino.h"
+#include "HostSim.h"
+#include <map>
+#include <deque>
+
+namespace {
+
+struct PinState {
+  int level = LOW;
+  int mode = 0;
+  void (*handler)() = nullptr;
+  int edge = 0;
+};
+
+std::map<int, PinState> pins;
+std::map<int, std::function<void(int)>> pinModeListeners;
+std::map<int, int> analogValues;
+std::deque<char> serialIn;
+std::string serialOut;
+bool serialEcho = false;
+std::vector<hostsim::Tone> toneLog;
+uint32_t rngState = 0x2545F491;
+
+uint32_t nextRandom() {
+  rngState ^= rngState << 13;
+  rngState ^= rngState >> 17;
+  rngState ^= rngState << 5;
+  return rngState;
+}
+
+void runHandler(void (*handler)()) {
+  // Pin interrupts land in interrupt context even when a script changes a pin from a task
+  if (hostsim::inInterrupt()) handler();
+  else hostsim::at(hostsim::nowUs(), handler);
+}
+
+}  // namespace
+
+namespace hostsim {
+
+void setPin(int pin, int level) {
+  PinState& p = pins[pin];
+  level = level ? HIGH : LOW;
+  if (p.level == level) return;
+  p.level = level;
+  if (!p.handler) return;
+  bool fire = p.edge == CHANGE || (p.edge == RISING && level == HIGH) || (p.edge == FALLING && level == LOW);
+  if (fire) runHandler(p.handler);
+}
+
+int pin(int pin) { return pins[pin].level; }
+void onPinMode(int pin, std::function<void(int mode)> listener) { pinModeListeners[pin] = listener; }
+void setAnalog(int pin, int value) { analogValues[pin] = value; }
+void seed(uint32_t value) { rngState = value ? value : 1; }
+
+void serialInput(const std::string& text) { serialIn.insert(serialIn.end(), text.begin(), text.end()); }
+void setSerialEcho(bool echo) { serialEcho = echo; }
+const std::string& serialOutput() { return serialOut; }
+void clearSerialOutput() { serialOut.clear(); }
+const std::vector<Tone>& tones() { return toneLog; }
+
+}  // namespace hostsim
+
+// === GPIO ===
+void pinMode(uint8_t pin, uint8_t mode) {
+  auto listener = pinModeListeners.find(pin);
+  if (listener != pinModeListeners.end()) listener->second(mode);
+  PinState& p = pins[pin];
+  if (mode == INPUT_PULLUP && p.mode != INPUT_PULLUP) p.level = HIGH;
+  p.mode = mode;
+}
+
+int digitalRead(uint8_t pin) { return pins[pin].level; }
+void digitalWrite(uint8_t pin, uint8_t level) { pins[pin].level = level ? HIGH : LOW; }
+
+uint16_t analogRead(uint8_t pin) {
+  auto it = analogValues.find(pin);
+  return it == analogValues.end() ? 2048 : it->second;
+}
+
+void attachInterrupt(uint8_t pin, void (*handler)(void), int mode) {
+  pins[pin].handler = handler;
+  pins[pin].edge = mode;
+}
+
+void detachInterrupt(uint8_t pin) { pins[pin].handler = nullptr; }
+
+void tone(uint8_t pin, unsigned int frequency, unsigned long duration) {
+  toneLog.push_back({ hostsim::nowUs(), frequency, duration });
+}
+
+void noTone(uint8_t pin) {}
+
+// === Math ===
+long random(long max) { return max > 0 ? nextRandom() % max : 0; }
+long random(long min, long max) { return max > min ? min + random(max - min) : min; }
+void randomSeed(unsigned long seed) { hostsim::seed(seed); }
+uint32_t esp_random() { return nextRandom(); }
+
+// === ESP32 ===
+EspClass ESP;
+uint32_t EspClass::getCycleCount() { return (uint32_t)(hostsim::nowUs() * getCpuFreqMHz()); }
+uint32_t EspClass::getFreeHeap() { return 300 * 1024; }
+
+// === Serial ===
+HardwareSerial Serial;
+
+int HardwareSerial::available() { return serialIn.size(); }
+
+int HardwareSerial::read() {
+  if (serialIn.empty()) return -1;
+  char c = serialIn.front();
+  serialIn.pop_front();
+  return (uint8_t)c;
+}
+
+size_t HardwareSerial::write(const uint8_t* data, size_t length) {
+  serialOut.append((const char*)data, length);
+  if (serialEcho) fwrite(data, 1, length, stdout);
+  return length;
+}
+
+size_t HardwareSerial::write(uint8_t c) { return write(&c, 1); }
+size_t HardwareSerial::print(const char* text) { return write((const uint8_t*)text, strlen(text)); }
+size_t HardwareSerial::print(char c) { return write((uint8_t)c); }
+size_t HardwareSerial::print(int value, int base) { return print((long)value, base); }
+size_t HardwareSerial::print(unsigned int value, int base) { return print((unsigned long)value, base); }
+
+size_t HardwareSerial::print(long value, int base) {
+  if (value < 0 && base == 10) return print('-') + print((unsigned long)-value, base);
+  return print((unsigned long)value, base);
+}
+
+size_t HardwareSerial::print(unsigned long value, int base) {
+  char buf[8 * sizeof(long) + 1];
+  char* p = buf + sizeof(buf) - 1;
+  *p = '\0';
+  if (base < 2) base = 10;
+  do {
+    int digit = value % base;
+    *--p = digit < 10 ? '0' + digit : 'A' + digit - 10;
+    value /= base;
+  } while (value);
+  return print(p);
+}
+
+size_t HardwareSerial::print(double value, int decimals) {
+  char buf[48];
+  snprintf(buf, sizeof(buf), "%.*f", decimals, value);
+  return print(buf);
+}
+
+size_t HardwareSerial::printf(const char* format, ...) {
+  char buf[256];
+  va_list args;
+  va_start(args, format);
+  int length = vsnprintf(buf, sizeof(buf), format, args);
+  va_end(args);
+  if (length < 0) return 0;
+  return write((const uint8_t*)buf, std::min((size_t)length, sizeof(buf) - 1));
+}
+
+// === String ===
+std::string String::format(double value, unsigned int decimals) {
+  char buf[48];
+  snprintf(buf, sizeof(buf), "%.*f", decimals, value);
+  return buf;
+}
+
+// Grows to fit exactly, the core's changeBuffer() realloc
+void String::reserve(unsigned int size) {
+  if (buf && size <= cap) return;
+  char* grown = new char[size + 1];
+  memcpy(grown, c_str(), len + 1);
+  delete[] buf;
+  buf = grown;
+  cap = size;
+}
+
+void String::assign(const char* text, unsigned int size) {
+  if (!size) {
+    len = 0;
+    if (buf) buf[0] = 0;
+    return;
+  }
+  reserve(size);
+  memmove(buf, text, size);
+  len = size;
+  buf[len] = 0;
+}
+
+void String::append(const char* text, unsigned int size) {
+  if (!size) return;
+  // The text may be this String's own, which reserve() is about to move
+  ptrdiff_t own = buf && text >= buf && text <= buf + len ? text - buf : -1;
+  reserve(len + size);
+  memcpy(buf + len, own >= 0 ? buf + own : text, size);
+  len += size;
+  buf[len] = 0;
+}
+
+int String::indexOf(char c, unsigned int from) const {
+  if (from >= len) return -1;
+  const char* found = (const char*)memchr(buf + from, c, len - from);
+  return found ? found - buf : -1;
+}
+
+int String::indexOf(const char* text, unsigned int from) const {
+  if (from > len) return -1;
+  const char* found = strstr(c_str() + from, text);
+  return found ? found - c_str() : -1;
+}
+
+int String::lastIndexOf(char c, unsigned int from) const {
+  if (!len) return -1;
+  for (int i = std::min(from, len - 1); i >= 0; i--) {
+    if (buf[i] == c) return i;
+  }
+  return -1;
+}
+
+String String::substring(unsigned int from, unsigned int to) const {
+  if (from > to) std::swap(from, to);
+  to = std::min(to, len);
+  String part;
+  if (from < to) part.assign(buf + from, to - from);
+  return part;
+}
+
+void String::remove(unsigned int index, unsigned int count) {
+  if (index >= len) return;
+  count = std::min(count, len - index);
+  memmove(buf + index, buf + index + count, len - index - count + 1);
+  len -= count;
+}
+
+void String::trim() {
+  unsigned int start = 0, end = len;
+  while (start < end && isspace((unsigned char)buf[start])) start++;
+  while (end > start && isspace((unsigned char)buf[end - 1])) end--;
+  if (start) memmove(buf, buf + start, end - start);
+  len = end - start;
+  if (buf) buf[len] = 0;
+}
+
+void String::replace(const String& from, const String& to) {
+  if (!from.len) return;
+  String result;
+  unsigned int at = 0;
+  for (int p = indexOf(from, 0); p >= 0; p = indexOf(from, at)) {
+    result.append(buf + at, p - at);
+    result.append(to.c_str(), to.len);
+    at = p + from.len;
+  }
+  if (!at) return;
+  result.append(buf + at, len - at);
+  *this = std::move(result);
+}
+
+void String::toUpperCase() {
+  for (unsigned int i = 0; i < len; i++) buf[i] = toupper((unsigned char)buf[i]);
+}
+
+void String::toLowerCase() {
+  for (unsigned int i = 0; i < len; i++) buf[i] = tolower((unsigned char)buf[i]);
+}
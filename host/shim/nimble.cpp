@@ -0,0 +1,149 @@
+// The phone and the NimBLE host for the simulator. Everything the device
+// would see from the stack happens in hostsim events, one connection interval apart.
+#include "NimBLEDevice.h"
+#include "HostSim.h"
+#include <memory>
+
+namespace {
+
+const uint16_t DEFAULT_MTU = 23;
+const uint16_t ATT_HEADER = 3;
+const uint8_t FRAGMENT_MAGIC = 0xDD;  // BleFragmenter in the app
+const size_t FRAGMENT_HEADER = 6;
+
+NimBLEServer server;
+NimBLEAdvertising advertising;
+std::vector<std::unique_ptr<NimBLEService>> services;
+std::vector<std::unique_ptr<NimBLECharacteristic>> characteristics;
+NimBLEConnInfo connInfo;
+
+uint16_t deviceMtu = DEFAULT_MTU;
+uint16_t peerMtu = DEFAULT_MTU;
+bool connected = false;
+bool advertisingOn = false;
+uint8_t nextFragmentId = 0;
+uint64_t nextWriteAt = 0;
+std::vector<hostsim::Notified> notifications;
+
+uint16_t negotiatedMtu() { return std::min(deviceMtu, peerMtu); }
+
+NimBLECharacteristic* writable() {
+  for (auto& c : characteristics) {
+    if (c->getProperties() & (NIMBLE_PROPERTY::WRITE | NIMBLE_PROPERTY::WRITE_NR)) return c.get();
+  }
+  return nullptr;
+}
+
+// Phone writes go out in order, at most one per connection interval
+void deliverWrite(std::vector<uint8_t> bytes) {
+  uint64_t when = std::max(hostsim::nowUs(), nextWriteAt);
+  nextWriteAt = when + hostsim::BLE_STATUS_DELAY_US;
+  hostsim::at(when, [bytes]() {
+    NimBLECharacteristic* c = writable();
+    if (!connected || !c) return;
+    c->setValue(bytes.data(), bytes.size());
+    if (c->getCallbacks()) c->getCallbacks()->onWrite(c, connInfo);
+  });
+}
+
+}  // namespace
+
+uint16_t NimBLEConnInfo::getMTU() const { return negotiatedMtu(); }
+
+bool NimBLECharacteristic::notify(bool isNotification) {
+  if (!connected) return false;
+  NimBLEAttValue sent = value;
+  size_t length = std::min(sent.size(), (size_t)(negotiatedMtu() - ATT_HEADER));
+  notifications.push_back({ hostsim::nowUs(), std::vector<uint8_t>(sent.data(), sent.data() + length) });
+
+  NimBLECharacteristic* self = this;
+  hostsim::at(hostsim::nowUs() + hostsim::BLE_STATUS_DELAY_US, [self]() {
+    if (self->getCallbacks()) self->getCallbacks()->onStatus(self, connected ? 0 : 7);
+  });
+  return true;
+}
+
+NimBLECharacteristic* NimBLEService::createCharacteristic(const char* uuid, uint32_t properties) {
+  characteristics.emplace_back(new NimBLECharacteristic(uuid, properties));
+  return characteristics.back().get();
+}
+
+NimBLEService* NimBLEServer::createService(const char* uuid) {
+  services.emplace_back(new NimBLEService());
+  return services.back().get();
+}
+
+uint16_t NimBLEServer::getPeerMTU(uint16_t connHandle) const { return negotiatedMtu(); }
+
+bool NimBLEAdvertising::start() {
+  advertisingOn = true;
+  return true;
+}
+
+bool NimBLEDevice::setMTU(uint16_t mtu) {
+  deviceMtu = mtu;
+  return true;
+}
+
+uint16_t NimBLEDevice::getMTU() { return deviceMtu; }
+NimBLEServer* NimBLEDevice::createServer() { return &server; }
+NimBLEAdvertising* NimBLEDevice::getAdvertising() { return &advertising; }
+
+namespace hostsim {
+
+void bleConnect(uint16_t mtu) {
+  at(nowUs(), [mtu]() {
+    if (connected || !advertisingOn) return;
+    connected = true;
+    advertisingOn = false;
+    peerMtu = DEFAULT_MTU;
+    if (server.getCallbacks()) server.getCallbacks()->onConnect(&server, connInfo);
+  });
+  if (mtu != DEFAULT_MTU) bleSetMtu(mtu);
+}
+
+void bleDisconnect() {
+  at(nowUs(), []() {
+    if (!connected) return;
+    connected = false;
+    if (server.getCallbacks()) server.getCallbacks()->onDisconnect(&server, connInfo, 0x13);
+  });
+}
+
+// The exchange takes one connection interval, like a real ATT MTU request
+void bleSetMtu(uint16_t mtu) {
+  at(nowUs() + BLE_STATUS_DELAY_US, [mtu]() {
+    if (!connected) return;
+    peerMtu = mtu;
+    if (server.getCallbacks()) server.getCallbacks()->onMTUChange(negotiatedMtu(), connInfo);
+  });
+}
+
+void bleWrite(const std::vector<uint8_t>& message) {
+  size_t maxWrite = negotiatedMtu() - ATT_HEADER;
+  if (message.size() <= maxWrite) {
+    deliverWrite(message);
+    return;
+  }
+
+  size_t chunk = maxWrite - FRAGMENT_HEADER;
+  uint8_t count = (message.size() + chunk - 1) / chunk;
+  uint8_t id = nextFragmentId++;
+  for (uint8_t index = 0; index < count; index++) {
+    std::vector<uint8_t> fragment = { FRAGMENT_MAGIC, id, index, count, (uint8_t)(message.size() & 0xFF),
+                                      (uint8_t)(message.size() >> 8) };
+    size_t from = index * chunk;
+    size_t to = std::min(message.size(), from + chunk);
+    fragment.insert(fragment.end(), message.begin() + from, message.begin() + to);
+    deliverWrite(fragment);
+  }
+}
+
+void bleWrite(const std::string& message) {
+  bleWrite(std::vector<uint8_t>(message.begin(), message.end()));
+}
+
+bool bleConnected() { return connected; }
+const std::vector<Notified>& bleNotifications() { return notifications; }
+
+}  // namespace hostsim
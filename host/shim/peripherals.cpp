@@ -0,0 +1,310 @@
+// Encoders, DHT11, the ADXL345 register model and the Wire bus it sits on
+#include "ESP32Encoder.h"
+#include "Adafruit_ADXL345_U.h"
+#include "Wire.h"
+#include "HostSim.h"
+#include <deque>
+#include <map>
+
+// === Encoders ===
+puType ESP32Encoder::useInternalWeakPullResistors = puType::down;
+
+namespace {
+std::map<int, ESP32Encoder*> encoders;  // by A pin
+}
+
+void ESP32Encoder::attachFullQuad(int aPin, int bPin) {
+  this->aPin = aPin;
+  encoders[aPin] = this;
+  if (useInternalWeakPullResistors == puType::up) {
+    pinMode(aPin, INPUT_PULLUP);
+    pinMode(bPin, INPUT_PULLUP);
+  }
+}
+
+namespace hostsim {
+
+// Full quad counts four edges per detent; A goes through two of them
+void turnEncoder(int pinA, int detents) {
+  auto it = encoders.find(pinA);
+  if (it == encoders.end()) return;
+  ESP32Encoder* encoder = it->second;
+  int step = detents < 0 ? -1 : 1;
+  for (int i = 0; i != detents; i += step) {
+    encoder->count += 4 * step;
+    setPin(pinA, !pin(pinA));
+    setPin(pinA, !pin(pinA));
+  }
+}
+
+}  // namespace hostsim
+
+// === DHT11 ===
+// The sensor's side of the single-wire protocol. A start pulse of at least 18 ms,
+// the pin set to OUTPUT and driven low, is answered once the sketch releases the
+// line: level changes at the datasheet timings, seen by its pin interrupt as on
+// the board.
+namespace {
+
+float climateTemperature = 22.0f;
+float climateHumidity = 45.0f;
+int dhtPin = -1;
+uint64_t dhtDrivenSince = hostsim::NEVER;
+std::vector<uint64_t> dhtReplyLog;
+
+const uint64_t DHT_START_MIN_US = 18000;
+const uint64_t DHT_RESPONSE_US = 30;  // release to the sensor pulling low
+const uint64_t DHT_PREAMBLE_US = 80;  // low, then high
+const uint64_t DHT_BIT_LOW_US = 50;
+const uint64_t DHT_ZERO_HIGH_US = 27;
+const uint64_t DHT_ONE_HIGH_US = 70;
+
+void dhtReply() {
+  if (isnan(climateTemperature) || isnan(climateHumidity)) return;
+  int humidity = constrain((int)lroundf(climateHumidity * 10), 0, 999);
+  int temperature = constrain((int)lroundf(fabsf(climateTemperature) * 10), 0, 1279);
+  uint8_t data[5] = { (uint8_t)(humidity / 10), (uint8_t)(humidity % 10), (uint8_t)(temperature / 10),
+                      (uint8_t)(temperature % 10 | (climateTemperature < 0 ? 0x80 : 0)), 0 };
+  data[4] = data[0] + data[1] + data[2] + data[3];
+
+  uint64_t t = hostsim::nowUs() + DHT_RESPONSE_US;
+  dhtReplyLog.push_back(t);
+  auto drive = [&t](int level, uint64_t holdUs) {
+    int pin = dhtPin;
+    hostsim::at(t, [pin, level]() { hostsim::setPin(pin, level); });
+    t += holdUs;
+  };
+  drive(LOW, DHT_PREAMBLE_US);
+  drive(HIGH, DHT_PREAMBLE_US);
+  for (int bit = 0; bit < 40; bit++) {
+    bool one = data[bit / 8] & (0x80 >> (bit % 8));
+    drive(LOW, DHT_BIT_LOW_US);
+    drive(HIGH, one ? DHT_ONE_HIGH_US : DHT_ZERO_HIGH_US);
+  }
+  drive(LOW, DHT_BIT_LOW_US);
+  drive(HIGH, 0);  // released, the pull-up holds it high
+}
+
+void dhtPinMode(int mode) {
+  if (mode == OUTPUT) {
+    dhtDrivenSince = hostsim::nowUs();
+    return;
+  }
+  bool started = dhtDrivenSince != hostsim::NEVER && hostsim::pin(dhtPin) == LOW &&
+                 hostsim::nowUs() - dhtDrivenSince >= DHT_START_MIN_US;
+  dhtDrivenSince = hostsim::NEVER;
+  if (started) dhtReply();
+}
+
+}  // namespace
+
+namespace hostsim {
+
+void setClimate(float temperature, float humidity) {
+  climateTemperature = temperature;
+  climateHumidity = humidity;
+}
+
+void wireDht11(int pin) {
+  dhtPin = pin;
+  onPinMode(pin, dhtPinMode);
+}
+
+const std::vector<uint64_t>& dhtReplies() { return dhtReplyLog; }
+
+}  // namespace hostsim
+
+// === ADXL345 ===
+namespace {
+
+const uint8_t ADXL_DEVID = 0xE5;
+const uint8_t FIFO_STREAM = 0x80;
+const uint8_t INT_ACTIVITY = 0x10;
+const size_t FIFO_DEPTH = 32;
+const float ACTIVITY_G_PER_LSB = 0.0625f;
+
+struct Sample {
+  int16_t x, y, z;
+};
+
+bool adxlPresent = true;
+uint8_t registers[64];
+std::deque<Sample> fifo;
+float accel[3] = { 0, 0, 1 };  // g, lying flat
+uint64_t lastFillUs = 0;
+int int1Pin = -1;
+
+uint32_t sampleRateMilliHz() {
+  // BW_RATE rate code 0xF is 3200 Hz, each step down halves it
+  int code = registers[ADXL345_REG_BW_RATE] & 0x0F;
+  return 3200000u >> (0x0F - code);
+}
+
+Sample currentSample() {
+  return { (int16_t)lroundf(accel[0] / ADXL345_MG2G_MULTIPLIER), (int16_t)lroundf(accel[1] / ADXL345_MG2G_MULTIPLIER),
+           (int16_t)lroundf(accel[2] / ADXL345_MG2G_MULTIPLIER) };
+}
+
+void pushSample(const Sample& s) {
+  if (fifo.size() == FIFO_DEPTH) fifo.pop_front();  // stream mode keeps the newest
+  fifo.push_back(s);
+}
+
+// Stream mode: the FIFO gains one sample of the current acceleration per output period
+void fillFifo() {
+  uint64_t now = hostsim::nowUs();
+  if (!(registers[ADXL345_REG_FIFO_CTL] & FIFO_STREAM)) {
+    lastFillUs = now;
+    return;
+  }
+  uint64_t periodUs = 1000000000ull / sampleRateMilliHz();
+  while (lastFillUs + periodUs <= now) {
+    lastFillUs += periodUs;
+    pushSample(currentSample());
+  }
+}
+
+void updateInt1() {
+  if (int1Pin < 0) return;
+  uint8_t pending = registers[ADXL345_REG_INT_SOURCE] & registers[ADXL345_REG_INT_ENABLE] & ~registers[ADXL345_REG_INT_MAP];
+  hostsim::setPin(int1Pin, pending ? HIGH : LOW);
+}
+
+uint8_t adxlRead(uint8_t reg) {
+  reg &= 0x3F;
+  if (reg == ADXL345_REG_DEVID) return ADXL_DEVID;
+  if (reg == ADXL345_REG_FIFO_STATUS) {
+    fillFifo();
+    return fifo.size();
+  }
+  if (reg == ADXL345_REG_INT_SOURCE) {
+    // Reading INT_SOURCE clears the latched activity and releases INT1
+    uint8_t value = registers[reg];
+    registers[reg] &= ~INT_ACTIVITY;
+    updateInt1();
+    return value;
+  }
+  return registers[reg];
+}
+
+void adxlWrite(uint8_t reg, uint8_t value) {
+  reg &= 0x3F;
+  if (reg == ADXL345_REG_FIFO_CTL) {
+    fillFifo();
+    if (!(value & FIFO_STREAM)) fifo.clear();
+  }
+  registers[reg] = value;
+  if (reg == ADXL345_REG_INT_ENABLE || reg == ADXL345_REG_INT_MAP) updateInt1();
+}
+
+// DATAX0..DATAZ1 in one burst: the oldest FIFO entry, or the live value with the FIFO off
+void adxlReadData(uint8_t* out) {
+  fillFifo();
+  Sample s = currentSample();
+  if (registers[ADXL345_REG_FIFO_CTL] & FIFO_STREAM) {
+    if (!fifo.empty()) {
+      s = fifo.front();
+      fifo.pop_front();
+    }
+  }
+  int16_t axes[3] = { s.x, s.y, s.z };
+  for (int i = 0; i < 3; i++) {
+    out[i * 2] = axes[i] & 0xFF;
+    out[i * 2 + 1] = (uint16_t)axes[i] >> 8;
+  }
+}
+
+}  // namespace
+
+namespace hostsim {
+
+void setAdxlPresent(bool present) { adxlPresent = present; }
+
+void setAcceleration(float x, float y, float z) {
+  fillFifo();  // samples taken before the change keep the old value
+  float next[3] = { x, y, z };
+  float threshold = registers[ADXL345_REG_THRESH_ACT] * ACTIVITY_G_PER_LSB;
+  bool active = false;
+  for (int i = 0; i < 3; i++) {
+    if (fabsf(next[i] - accel[i]) > threshold) active = true;
+    accel[i] = next[i];
+  }
+  if (active && threshold > 0 && (registers[ADXL345_REG_INT_ENABLE] & INT_ACTIVITY)) {
+    registers[ADXL345_REG_INT_SOURCE] |= INT_ACTIVITY;
+    updateInt1();
+  }
+}
+
+void queueAccelSamples(const std::vector<std::vector<int16_t>>& samples) {
+  fillFifo();
+  for (const auto& s : samples) {
+    pushSample({ s.size() > 0 ? s[0] : (int16_t)0, s.size() > 1 ? s[1] : (int16_t)0, s.size() > 2 ? s[2] : (int16_t)0 });
+  }
+}
+
+void wireAdxlInt1(int pin) {
+  int1Pin = pin;
+  updateInt1();
+}
+
+}  // namespace hostsim
+
+bool Adafruit_ADXL345_Unified::begin(uint8_t addr) {
+  if (!adxlPresent || addr != ADXL345_DEFAULT_ADDRESS) return false;
+  writeRegister(ADXL345_REG_POWER_CTL, 0x08);  // measure
+  return true;
+}
+
+bool Adafruit_ADXL345_Unified::getEvent(sensors_event_t* event) {
+  uint8_t data[6];
+  adxlReadData(data);
+  event->sensor_id = sensorID;
+  event->timestamp = millis();
+  event->acceleration.x = (int16_t)(data[1] << 8 | data[0]) * ADXL345_MG2G_MULTIPLIER * SENSORS_GRAVITY_STANDARD;
+  event->acceleration.y = (int16_t)(data[3] << 8 | data[2]) * ADXL345_MG2G_MULTIPLIER * SENSORS_GRAVITY_STANDARD;
+  event->acceleration.z = (int16_t)(data[5] << 8 | data[4]) * ADXL345_MG2G_MULTIPLIER * SENSORS_GRAVITY_STANDARD;
+  return true;
+}
+
+void Adafruit_ADXL345_Unified::writeRegister(uint8_t reg, uint8_t value) { adxlWrite(reg, value); }
+uint8_t Adafruit_ADXL345_Unified::readRegister(uint8_t reg) { return adxlRead(reg); }
+
+// === Wire ===
+TwoWire Wire;
+
+void TwoWire::beginTransmission(uint8_t address) {
+  this->address = address;
+  txLength = 0;
+}
+
+size_t TwoWire::write(uint8_t data) {
+  if (txLength == sizeof(txBuffer)) return 0;
+  txBuffer[txLength++] = data;
+  return 1;
+}
+
+// 0 on ACK, 2 when nobody answers the address
+uint8_t TwoWire::endTransmission(bool sendStop) {
+  if (address != ADXL345_DEFAULT_ADDRESS || !adxlPresent) return 2;
+  // First byte sets the register pointer, the rest are written from there
+  for (uint8_t i = 1; i < txLength; i++) adxlWrite(txBuffer[0] + i - 1, txBuffer[i]);
+  return 0;
+}
+
+uint8_t TwoWire::requestFrom(uint8_t address, uint8_t quantity, bool sendStop) {
+  rxLength = rxIndex = 0;
+  if (address != ADXL345_DEFAULT_ADDRESS || !adxlPresent || txLength == 0) return 0;
+  quantity = std::min<uint8_t>(quantity, sizeof(rxBuffer));
+
+  uint8_t reg = txBuffer[0];
+  if (reg == ADXL345_REG_DATAX0 && quantity == 6) {
+    adxlReadData(rxBuffer);
+  } else {
+    for (uint8_t i = 0; i < quantity; i++) rxBuffer[i] = adxlRead(reg + i);
+  }
+  rxLength = quantity;
+  return quantity;
+}
+
+int TwoWire::available() { return rxLength - rxIndex; }
+int TwoWire::read() { return rxIndex < rxLength ? rxBuffer[rxIndex++] : -1; }
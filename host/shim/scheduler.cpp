@@ -0,0 +1,321 @@
+// Virtual clock and a single-core, priority-preemptive stand-in for FreeRTOS.
+// Tasks are ucontext coroutines: exactly one runs at a time, switches happen
+// only inside blocking or waking calls, and time jumps to the next deadline
+// once every task is blocked. The same script therefore always produces the
+// same interleaving, frame for frame.
+#include "Arduino.h"
+#include "HostSim.h"
+#include <ucontext.h>
+#include <map>
+#include <memory>
+
+namespace {
+
+struct Semaphore;
+
+struct Task {
+  std::string name;
+  int priority = 1;
+  ucontext_t context;
+  std::unique_ptr<uint8_t[]> stack;
+  TaskFunction_t function = nullptr;
+  void* param = nullptr;
+
+  bool ready = true;
+  bool finished = false;
+  uint64_t wakeAt = hostsim::NEVER;
+  uint64_t readySince = 0;  // FIFO order among tasks of equal priority
+  uint64_t switches = 0;
+
+  uint32_t notifyValue = 0;
+  bool waitingNotify = false;
+  Semaphore* waitingOn = nullptr;
+};
+
+struct Semaphore {
+  bool given = false;
+};
+
+const size_t TASK_STACK_BYTES = 256 * 1024;
+
+uint64_t clockUs = 0;
+uint64_t readySequence = 0;
+int interruptDepth = 0;
+bool stopping = false;
+std::multimap<uint64_t, std::function<void()>> events;
+std::vector<std::unique_ptr<Task>> allTasks;
+Task* current = nullptr;
+
+Task* loopTask() {
+  if (allTasks.empty()) {
+    allTasks.emplace_back(new Task());
+    allTasks[0]->name = "loopTask";
+    current = allTasks[0].get();
+  }
+  return allTasks[0].get();
+}
+
+Task* running() {
+  loopTask();
+  return current;
+}
+
+Task* pickReady() {
+  Task* self = running();
+  Task* best = nullptr;
+  for (auto& t : allTasks) {
+    if (!t->ready || t->finished) continue;
+    if (!best || t->priority > best->priority) {
+      best = t.get();
+    } else if (t->priority == best->priority && best != self &&
+               (t.get() == self || t->readySince < best->readySince)) {
+      best = t.get();  // no time slicing: the running task keeps the core among equals
+    }
+  }
+  return best;
+}
+
+void makeReady(Task* t) {
+  if (t->ready) return;
+  t->ready = true;
+  t->wakeAt = hostsim::NEVER;
+  t->readySince = ++readySequence;
+}
+
+void runDueEvents() {
+  while (!events.empty() && events.begin()->first <= clockUs) {
+    auto event = std::move(events.begin()->second);
+    events.erase(events.begin());
+    interruptDepth++;
+    event();
+    interruptDepth--;
+  }
+}
+
+// Nothing can run: jump to the next timeout or event
+void advanceClock() {
+  uint64_t next = hostsim::NEVER;
+  for (auto& t : allTasks) {
+    if (!t->ready && !t->finished && t->wakeAt < next) next = t->wakeAt;
+  }
+  if (!events.empty() && events.begin()->first < next) next = events.begin()->first;
+  if (next == hostsim::NEVER) {
+    fprintf(stderr, "hostsim: every task is blocked with nothing left to wake it\n");
+    exit(3);
+  }
+
+  if (next > clockUs) clockUs = next;
+  runDueEvents();
+  for (auto& t : allTasks) {
+    if (!t->ready && !t->finished && t->wakeAt <= clockUs) makeReady(t.get());
+  }
+}
+
+void switchTo(Task* next) {
+  Task* previous = running();
+  if (next == previous) return;
+  current = next;
+  next->switches++;
+  swapcontext(&previous->context, &next->context);
+}
+
+void schedule() {
+  for (;;) {
+    Task* next = pickReady();
+    if (next) {
+      switchTo(next);
+      return;
+    }
+    advanceClock();
+  }
+}
+
+// Block the running task until it is woken or the deadline passes
+void block(uint64_t deadline) {
+  if (interruptDepth > 0) {
+    fprintf(stderr, "hostsim: blocking call from interrupt context\n");
+    abort();
+  }
+  Task* self = running();
+  if (deadline <= clockUs) return;
+  self->ready = false;
+  self->wakeAt = deadline;
+  schedule();
+}
+
+// A task made ready from task context takes the core at once if it outranks the caller
+void preemptIfNeeded(Task* woken) {
+  if (interruptDepth == 0 && woken->ready && woken->priority > running()->priority) schedule();
+}
+
+void wake(Task* t) {
+  makeReady(t);
+  preemptIfNeeded(t);
+}
+
+void taskEntry() {
+  Task* self = current;
+  self->function(self->param);
+  self->finished = true;
+  self->ready = false;
+  schedule();
+}
+
+uint64_t deadlineAfter(TickType_t ticks) {
+  return ticks == portMAX_DELAY ? hostsim::NEVER : clockUs + (uint64_t)ticks * 1000;
+}
+
+}  // namespace
+
+namespace hostsim {
+
+uint64_t nowUs() { return clockUs; }
+
+void at(uint64_t timeUs, std::function<void()> event) {
+  events.emplace(std::max(timeUs, clockUs), std::move(event));
+}
+
+void advance(uint64_t us) {
+  uint64_t until = clockUs + us;
+  while (clockUs < until && !stopping) block(until);
+}
+
+bool inInterrupt() { return interruptDepth > 0; }
+
+void requestStop() {
+  stopping = true;
+  Task* main = loopTask();
+  if (!main->ready) makeReady(main);
+}
+
+bool stopRequested() { return stopping; }
+
+std::vector<TaskInfo> tasks() {
+  loopTask();
+  std::vector<TaskInfo> out;
+  for (auto& t : allTasks) out.push_back({ t->name, t->priority, t->ready, t->switches });
+  return out;
+}
+
+}  // namespace hostsim
+
+// === Timing ===
+unsigned long millis() { return clockUs / 1000; }
+unsigned long micros() { return clockUs; }
+int64_t esp_timer_get_time() { return clockUs; }
+void delay(unsigned long ms) { hostsim::advance((uint64_t)ms * 1000); }
+void delayMicroseconds(unsigned int us) { hostsim::advance(us); }
+
+// === Tasks ===
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t function, const char* name, uint32_t stackDepth, void* param,
+                                   UBaseType_t priority, TaskHandle_t* handle, BaseType_t core) {
+  loopTask();
+  Task* t = new Task();
+  allTasks.emplace_back(t);
+  t->name = name;
+  t->priority = priority;
+  t->function = function;
+  t->param = param;
+  t->stack.reset(new uint8_t[TASK_STACK_BYTES]);
+  t->readySince = ++readySequence;
+  getcontext(&t->context);
+  t->context.uc_stack.ss_sp = t->stack.get();
+  t->context.uc_stack.ss_size = TASK_STACK_BYTES;
+  t->context.uc_link = nullptr;
+  makecontext(&t->context, taskEntry, 0);
+  if (handle) *handle = t;
+
+  preemptIfNeeded(t);
+  return pdPASS;
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle() { return running(); }
+TickType_t xTaskGetTickCount() { return clockUs / 1000; }
+
+void vTaskDelay(TickType_t ticks) {
+  block(deadlineAfter(ticks));
+}
+
+void vTaskDelayUntil(TickType_t* previousWake, TickType_t increment) {
+  *previousWake += increment;
+  block((uint64_t)*previousWake * 1000);
+}
+
+void taskYIELD() {
+  Task* self = running();
+  self->readySince = ++readySequence;  // behind any other ready task of its priority
+  Task* next = pickReady();
+  for (auto& t : allTasks) {
+    if (t.get() != self && t->ready && !t->finished && t->priority == self->priority && t->readySince < self->readySince) {
+      next = t.get();
+      break;
+    }
+  }
+  if (next && next != self) switchTo(next);
+}
+
+// Events already return to the scheduler, which picks the highest priority task
+void hostYieldFromISR() {}
+
+uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t ticksToWait) {
+  Task* self = running();
+  if (self->notifyValue == 0 && ticksToWait > 0) {
+    self->waitingNotify = true;
+    block(deadlineAfter(ticksToWait));
+    self->waitingNotify = false;
+  }
+  uint32_t value = self->notifyValue;
+  if (value) self->notifyValue = clearOnExit ? 0 : value - 1;
+  return value;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task) {
+  if (!task) return pdFALSE;
+  Task* t = (Task*)task;
+  t->notifyValue++;
+  if (t->waitingNotify) wake(t);
+  return pdPASS;
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t* higherPriorityTaskWoken) {
+  xTaskNotifyGive(task);
+  if (higherPriorityTaskWoken) *higherPriorityTaskWoken = pdTRUE;
+}
+
+// === Semaphores ===
+SemaphoreHandle_t xSemaphoreCreateBinary() {
+  return new Semaphore();
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticksToWait) {
+  Semaphore* s = (Semaphore*)semaphore;
+  Task* self = running();
+  uint64_t deadline = deadlineAfter(ticksToWait);
+  while (!s->given) {
+    if (clockUs >= deadline || hostsim::stopRequested()) return pdFALSE;
+    self->waitingOn = s;
+    block(deadline);
+    self->waitingOn = nullptr;
+  }
+  s->given = false;
+  return pdTRUE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore) {
+  Semaphore* s = (Semaphore*)semaphore;
+  if (s->given) return pdFALSE;
+  s->given = true;
+
+  Task* waiter = nullptr;
+  for (auto& t : allTasks) {
+    if (t->waitingOn == s && !t->ready && (!waiter || t->priority > waiter->priority)) waiter = t.get();
+  }
+  if (waiter) wake(waiter);
+  return pdTRUE;
+}
+
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t semaphore, BaseType_t* higherPriorityTaskWoken) {
+  BaseType_t given = xSemaphoreGive(semaphore);
+  if (higherPriorityTaskWoken) *higherPriorityTaskWoken = pdFALSE;
+  return given;
+}
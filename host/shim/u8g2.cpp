@@ -0,0 +1,379 @@
+// Frame buffer drawing, stand-in fonts and the simulated SH1106 panel
+#include "U8g2lib.h"
+#include "HostSim.h"
+
+const u8g2_cb_t u8g2_cb_r0 = { 0 };
+
+// { advance, scale, bold }
+const uint8_t u8g2_font_4x6_tf[] = { 4, 1, 0 };
+const uint8_t u8g2_font_6x10_tf[] = { 6, 1, 0 };
+const uint8_t u8g2_font_6x12_tf[] = { 6, 1, 0 };
+const uint8_t u8g2_font_7x13_tf[] = { 7, 1, 0 };
+const uint8_t u8g2_font_7x13B_tf[] = { 7, 1, 1 };
+const uint8_t u8g2_font_ncenB10_tf[] = { 9, 1, 1 };
+const uint8_t u8g2_font_courB24_tn[] = { 20, 3, 1 };
+const uint8_t u8g2_font_logisoso18_tr[] = { 11, 2, 0 };
+const uint8_t u8g2_font_logisoso24_tr[] = { 16, 3, 0 };
+
+namespace {
+
+const int WIDTH = 128;
+const int HEIGHT = 64;
+const int GLYPH_COLUMNS = 5;
+
+// Printable ASCII, column-major, bit 0 is the top row and bit 7 the descender
+const uint8_t GLYPHS[][GLYPH_COLUMNS] = {
+  { 0x00, 0x00, 0x00, 0x00, 0x00 }, { 0x00, 0x00, 0x5F, 0x00, 0x00 }, { 0x00, 0x07, 0x00, 0x07, 0x00 },
+  { 0x14, 0x7F, 0x14, 0x7F, 0x14 }, { 0x24, 0x2A, 0x7F, 0x2A, 0x12 }, { 0x23, 0x13, 0x08, 0x64, 0x62 },
+  { 0x36, 0x49, 0x56, 0x20, 0x50 }, { 0x00, 0x08, 0x07, 0x03, 0x00 }, { 0x00, 0x1C, 0x22, 0x41, 0x00 },
+  { 0x00, 0x41, 0x22, 0x1C, 0x00 }, { 0x2A, 0x1C, 0x7F, 0x1C, 0x2A }, { 0x08, 0x08, 0x3E, 0x08, 0x08 },
+  { 0x00, 0x80, 0x70, 0x30, 0x00 }, { 0x08, 0x08, 0x08, 0x08, 0x08 }, { 0x00, 0x00, 0x60, 0x60, 0x00 },
+  { 0x20, 0x10, 0x08, 0x04, 0x02 }, { 0x3E, 0x51, 0x49, 0x45, 0x3E }, { 0x00, 0x42, 0x7F, 0x40, 0x00 },
+  { 0x72, 0x49, 0x49, 0x49, 0x46 }, { 0x21, 0x41, 0x49, 0x4D, 0x33 }, { 0x18, 0x14, 0x12, 0x7F, 0x10 },
+  { 0x27, 0x45, 0x45, 0x45, 0x39 }, { 0x3C, 0x4A, 0x49, 0x49, 0x31 }, { 0x41, 0x21, 0x11, 0x09, 0x07 },
+  { 0x36, 0x49, 0x49, 0x49, 0x36 }, { 0x46, 0x49, 0x49, 0x29, 0x1E }, { 0x00, 0x00, 0x14, 0x00, 0x00 },
+  { 0x00, 0x40, 0x34, 0x00, 0x00 }, { 0x00, 0x08, 0x14, 0x22, 0x41 }, { 0x14, 0x14, 0x14, 0x14, 0x14 },
+  { 0x00, 0x41, 0x22, 0x14, 0x08 }, { 0x02, 0x01, 0x59, 0x09, 0x06 }, { 0x3E, 0x41, 0x5D, 0x59, 0x4E },
+  { 0x7C, 0x12, 0x11, 0x12, 0x7C }, { 0x7F, 0x49, 0x49, 0x49, 0x36 }, { 0x3E, 0x41, 0x41, 0x41, 0x22 },
+  { 0x7F, 0x41, 0x41, 0x41, 0x3E }, { 0x7F, 0x49, 0x49, 0x49, 0x41 }, { 0x7F, 0x09, 0x09, 0x09, 0x01 },
+  { 0x3E, 0x41, 0x41, 0x51, 0x73 }, { 0x7F, 0x08, 0x08, 0x08, 0x7F }, { 0x00, 0x41, 0x7F, 0x41, 0x00 },
+  { 0x20, 0x40, 0x41, 0x3F, 0x01 }, { 0x7F, 0x08, 0x14, 0x22, 0x41 }, { 0x7F, 0x40, 0x40, 0x40, 0x40 },
+  { 0x7F, 0x02, 0x1C, 0x02, 0x7F }, { 0x7F, 0x04, 0x08, 0x10, 0x7F }, { 0x3E, 0x41, 0x41, 0x41, 0x3E },
+  { 0x7F, 0x09, 0x09, 0x09, 0x06 }, { 0x3E, 0x41, 0x51, 0x21, 0x5E }, { 0x7F, 0x09, 0x19, 0x29, 0x46 },
+  { 0x26, 0x49, 0x49, 0x49, 0x32 }, { 0x03, 0x01, 0x7F, 0x01, 0x03 }, { 0x3F, 0x40, 0x40, 0x40, 0x3F },
+  { 0x1F, 0x20, 0x40, 0x20, 0x1F }, { 0x3F, 0x40, 0x38, 0x40, 0x3F }, { 0x63, 0x14, 0x08, 0x14, 0x63 },
+  { 0x03, 0x04, 0x78, 0x04, 0x03 }, { 0x61, 0x59, 0x49, 0x4D, 0x43 }, { 0x00, 0x7F, 0x41, 0x41, 0x41 },
+  { 0x02, 0x04, 0x08, 0x10, 0x20 }, { 0x00, 0x41, 0x41, 0x41, 0x7F }, { 0x04, 0x02, 0x01, 0x02, 0x04 },
+  { 0x40, 0x40, 0x40, 0x40, 0x40 }, { 0x00, 0x03, 0x07, 0x08, 0x00 }, { 0x20, 0x54, 0x54, 0x78, 0x40 },
+  { 0x7F, 0x28, 0x44, 0x44, 0x38 }, { 0x38, 0x44, 0x44, 0x44, 0x28 }, { 0x38, 0x44, 0x44, 0x28, 0x7F },
+  { 0x38, 0x54, 0x54, 0x54, 0x18 }, { 0x00, 0x08, 0x7E, 0x09, 0x02 }, { 0x18, 0xA4, 0xA4, 0x9C, 0x78 },
+  { 0x7F, 0x08, 0x04, 0x04, 0x78 }, { 0x00, 0x44, 0x7D, 0x40, 0x00 }, { 0x20, 0x40, 0x40, 0x3D, 0x00 },
+  { 0x7F, 0x10, 0x28, 0x44, 0x00 }, { 0x00, 0x41, 0x7F, 0x40, 0x00 }, { 0x7C, 0x04, 0x78, 0x04, 0x78 },
+  { 0x7C, 0x08, 0x04, 0x04, 0x78 }, { 0x38, 0x44, 0x44, 0x44, 0x38 }, { 0xFC, 0x18, 0x24, 0x24, 0x18 },
+  { 0x18, 0x24, 0x24, 0x18, 0xFC }, { 0x7C, 0x08, 0x04, 0x04, 0x08 }, { 0x48, 0x54, 0x54, 0x54, 0x24 },
+  { 0x04, 0x04, 0x3F, 0x44, 0x24 }, { 0x3C, 0x40, 0x40, 0x20, 0x7C }, { 0x1C, 0x20, 0x40, 0x20, 0x1C },
+  { 0x3C, 0x40, 0x30, 0x40, 0x3C }, { 0x44, 0x28, 0x10, 0x28, 0x44 }, { 0x4C, 0x90, 0x90, 0x90, 0x7C },
+  { 0x44, 0x64, 0x54, 0x4C, 0x44 }, { 0x00, 0x08, 0x36, 0x41, 0x00 }, { 0x00, 0x00, 0x77, 0x00, 0x00 },
+  { 0x00, 0x41, 0x36, 0x08, 0x00 }, { 0x02, 0x01, 0x02, 0x04, 0x02 },
+};
+const uint8_t MISSING_GLYPH[GLYPH_COLUMNS] = { 0x7F, 0x41, 0x41, 0x41, 0x7F };
+
+uint8_t gddram[WIDTH * HEIGHT / 8];
+uint8_t contrast = 0xFF;
+bool powerSave = true;
+uint64_t bytesWritten = 0;
+uint64_t tileWrites = 0;
+uint64_t pendingNs = 0;
+
+const uint8_t* glyphFor(uint32_t code) {
+  if (code >= 0x20 && code <= 0x7E) return GLYPHS[code - 0x20];
+  return MISSING_GLYPH;
+}
+
+uint32_t nextCodepoint(const char*& s, bool utf8) {
+  uint8_t c = *s++;
+  if (!utf8 || c < 0x80) return c;
+  int extra = c >= 0xF0 ? 3 : c >= 0xE0 ? 2 : c >= 0xC0 ? 1 : 0;
+  uint32_t code = c & (0x3F >> extra);
+  while (extra-- && (*s & 0xC0) == 0x80) code = code << 6 | (*s++ & 0x3F);
+  return code;
+}
+
+const uint8_t* fontOrDefault(const uint8_t* font) {
+  return font ? font : u8g2_font_6x10_tf;
+}
+
+}  // namespace
+
+// === Panel ===
+// Command overhead per DrawTile: address byte, control byte, page and column setup
+static const int DRAW_TILE_OVERHEAD_BYTES = 6;
+
+static void chargeI2C(uint64_t bytes) {
+  pendingNs += bytes * hostsim::I2C_NS_PER_BYTE;
+  uint64_t us = pendingNs / 1000;
+  pendingNs %= 1000;
+  if (us && !hostsim::inInterrupt()) hostsim::advance(us);
+}
+
+uint8_t u8x8_DrawTile(u8x8_t* u8x8, uint8_t x, uint8_t y, uint8_t count, uint8_t* tiles) {
+  if (y >= HEIGHT / 8 || x >= WIDTH / 8) return 0;
+  int bytes = std::min<int>(count, WIDTH / 8 - x) * 8;
+  memcpy(gddram + y * WIDTH + x * 8, tiles, bytes);
+  bytesWritten += bytes;
+  tileWrites++;
+  chargeI2C(bytes + DRAW_TILE_OVERHEAD_BYTES);
+  return 1;
+}
+
+void u8x8_SetContrast(u8x8_t* u8x8, uint8_t value) {
+  contrast = value;
+  chargeI2C(3);
+}
+
+void u8x8_SetPowerSave(u8x8_t* u8x8, uint8_t isEnable) {
+  powerSave = isEnable;
+  chargeI2C(2);
+}
+
+namespace hostsim {
+
+const uint8_t* panel() { return gddram; }
+uint8_t panelContrast() { return contrast; }
+bool panelPowerSave() { return powerSave; }
+uint64_t panelBytesWritten() { return bytesWritten; }
+uint64_t panelTileWrites() { return tileWrites; }
+
+// Binary PBM (P4), lit pixels black
+bool writePbm(const std::string& path, const uint8_t* pageMajor, int width, int height) {
+  FILE* f = fopen(path.c_str(), "wb");
+  if (!f) return false;
+  fprintf(f, "P4\n%d %d\n", width, height);
+  std::vector<uint8_t> row((width + 7) / 8);
+  for (int y = 0; y < height; y++) {
+    std::fill(row.begin(), row.end(), 0);
+    for (int x = 0; x < width; x++) {
+      if (pageMajor[(y / 8) * width + x] & (1 << (y & 7))) row[x / 8] |= 0x80 >> (x & 7);
+    }
+    fwrite(row.data(), 1, row.size(), f);
+  }
+  return fclose(f) == 0;
+}
+
+}  // namespace hostsim
+
+// === U8G2 ===
+U8G2::U8G2() {
+  u.u8x8.tileWidth = WIDTH / 8;
+  u.u8x8.tileHeight = HEIGHT / 8;
+  u.tile_buf_ptr = buffer;
+  u.draw_color = 1;
+  u.bitmap_transparency = 0;
+  u.font_mode = 0;
+  u.font = nullptr;
+  memset(buffer, 0, sizeof(buffer));
+}
+
+bool U8G2::begin() {
+  clearBuffer();
+  sendBuffer();
+  u8x8_SetPowerSave(getU8x8(), 0);
+  return true;
+}
+
+void U8G2::clearBuffer() {
+  memset(u.tile_buf_ptr, 0, WIDTH * HEIGHT / 8);
+}
+
+void U8G2::sendBuffer() {
+  for (int page = 0; page < HEIGHT / 8; page++) {
+    u8x8_DrawTile(getU8x8(), 0, page, WIDTH / 8, u.tile_buf_ptr + page * WIDTH);
+  }
+}
+
+void U8G2::pixel(int x, int y, uint8_t color) {
+  if (x < 0 || y < 0 || x >= WIDTH || y >= HEIGHT) return;
+  uint8_t mask = 1 << (y & 7);
+  uint8_t& b = u.tile_buf_ptr[(y >> 3) * WIDTH + x];
+  if (color == 0) b &= ~mask;
+  else if (color == 1) b |= mask;
+  else b ^= mask;
+}
+
+void U8G2::drawPixel(int x, int y) { pixel(x, y, u.draw_color); }
+
+void U8G2::drawHLine(int x, int y, int w) {
+  for (int i = 0; i < w; i++) pixel(x + i, y, u.draw_color);
+}
+
+void U8G2::drawVLine(int x, int y, int h) {
+  for (int i = 0; i < h; i++) pixel(x, y + i, u.draw_color);
+}
+
+void U8G2::span(int x1, int x2, int y) {
+  if (x1 > x2) std::swap(x1, x2);
+  drawHLine(x1, y, x2 - x1 + 1);
+}
+
+void U8G2::drawLine(int x1, int y1, int x2, int y2) {
+  int dx = abs(x2 - x1), sx = x1 < x2 ? 1 : -1;
+  int dy = -abs(y2 - y1), sy = y1 < y2 ? 1 : -1;
+  int err = dx + dy;
+  for (;;) {
+    pixel(x1, y1, u.draw_color);
+    if (x1 == x2 && y1 == y2) break;
+    int e2 = 2 * err;
+    if (e2 >= dy) { err += dy; x1 += sx; }
+    if (e2 <= dx) { err += dx; y1 += sy; }
+  }
+}
+
+void U8G2::drawBox(int x, int y, int w, int h) {
+  for (int i = 0; i < h; i++) drawHLine(x, y + i, w);
+}
+
+void U8G2::drawFrame(int x, int y, int w, int h) {
+  if (w <= 0 || h <= 0) return;
+  drawHLine(x, y, w);
+  if (h > 1) drawHLine(x, y + h - 1, w);
+  if (h > 2) {
+    drawVLine(x, y + 1, h - 2);
+    if (w > 1) drawVLine(x + w - 1, y + 1, h - 2);
+  }
+}
+
+void U8G2::drawRBox(int x, int y, int w, int h, int r) {
+  if (w <= 0 || h <= 0) return;
+  r = std::min(r, std::min(w, h) / 2);
+  drawDisc(x + r, y + r, r, U8G2_DRAW_UPPER_LEFT);
+  drawDisc(x + w - r - 1, y + r, r, U8G2_DRAW_UPPER_RIGHT);
+  drawDisc(x + r, y + h - r - 1, r, U8G2_DRAW_LOWER_LEFT);
+  drawDisc(x + w - r - 1, y + h - r - 1, r, U8G2_DRAW_LOWER_RIGHT);
+  drawBox(x + r + 1, y, w - 2 * r - 2, r + 1);
+  drawBox(x + r + 1, y + h - r - 1, w - 2 * r - 2, r + 1);
+  drawBox(x, y + r + 1, w, h - 2 * r - 2);
+}
+
+void U8G2::drawRFrame(int x, int y, int w, int h, int r) {
+  if (w <= 0 || h <= 0) return;
+  r = std::min(r, std::min(w, h) / 2);
+  drawCircle(x + r, y + r, r, U8G2_DRAW_UPPER_LEFT);
+  drawCircle(x + w - r - 1, y + r, r, U8G2_DRAW_UPPER_RIGHT);
+  drawCircle(x + r, y + h - r - 1, r, U8G2_DRAW_LOWER_LEFT);
+  drawCircle(x + w - r - 1, y + h - r - 1, r, U8G2_DRAW_LOWER_RIGHT);
+  drawHLine(x + r + 1, y, w - 2 * r - 2);
+  drawHLine(x + r + 1, y + h - 1, w - 2 * r - 2);
+  drawVLine(x, y + r + 1, h - 2 * r - 2);
+  drawVLine(x + w - 1, y + r + 1, h - 2 * r - 2);
+}
+
+void U8G2::circlePoints(int x0, int y0, int x, int y, uint8_t option, bool fill) {
+  if (fill) {
+    if (option & U8G2_DRAW_UPPER_RIGHT) { drawVLine(x0 + x, y0 - y, y + 1); drawVLine(x0 + y, y0 - x, x + 1); }
+    if (option & U8G2_DRAW_UPPER_LEFT) { drawVLine(x0 - x, y0 - y, y + 1); drawVLine(x0 - y, y0 - x, x + 1); }
+    if (option & U8G2_DRAW_LOWER_RIGHT) { drawVLine(x0 + x, y0, y + 1); drawVLine(x0 + y, y0, x + 1); }
+    if (option & U8G2_DRAW_LOWER_LEFT) { drawVLine(x0 - x, y0, y + 1); drawVLine(x0 - y, y0, x + 1); }
+    return;
+  }
+  uint8_t c = u.draw_color;
+  if (option & U8G2_DRAW_UPPER_RIGHT) { pixel(x0 + x, y0 - y, c); pixel(x0 + y, y0 - x, c); }
+  if (option & U8G2_DRAW_UPPER_LEFT) { pixel(x0 - x, y0 - y, c); pixel(x0 - y, y0 - x, c); }
+  if (option & U8G2_DRAW_LOWER_RIGHT) { pixel(x0 + x, y0 + y, c); pixel(x0 + y, y0 + x, c); }
+  if (option & U8G2_DRAW_LOWER_LEFT) { pixel(x0 - x, y0 + y, c); pixel(x0 - y, y0 + x, c); }
+}
+
+// Midpoint circle, same stepping as u8g2_draw_circle / u8g2_draw_disc
+void U8G2::drawCircle(int x0, int y0, int rad, uint8_t option) {
+  int f = 1 - rad, ddfX = 1, ddfY = -2 * rad, x = 0, y = rad;
+  circlePoints(x0, y0, x, y, option, false);
+  while (x < y) {
+    if (f >= 0) { y--; ddfY += 2; f += ddfY; }
+    x++; ddfX += 2; f += ddfX;
+    circlePoints(x0, y0, x, y, option, false);
+  }
+}
+
+void U8G2::drawDisc(int x0, int y0, int rad, uint8_t option) {
+  int f = 1 - rad, ddfX = 1, ddfY = -2 * rad, x = 0, y = rad;
+  circlePoints(x0, y0, x, y, option, true);
+  while (x < y) {
+    if (f >= 0) { y--; ddfY += 2; f += ddfY; }
+    x++; ddfX += 2; f += ddfX;
+    circlePoints(x0, y0, x, y, option, true);
+  }
+}
+
+void U8G2::drawTriangle(int x0, int y0, int x1, int y1, int x2, int y2) {
+  if (y0 > y1) { std::swap(x0, x1); std::swap(y0, y1); }
+  if (y1 > y2) { std::swap(x1, x2); std::swap(y1, y2); }
+  if (y0 > y1) { std::swap(x0, x1); std::swap(y0, y1); }
+  for (int y = y0; y <= y2; y++) {
+    // Long edge 0-2 against whichever short edge covers this row
+    int xa = y2 == y0 ? x0 : x0 + (x2 - x0) * (y - y0) / (y2 - y0);
+    int xb;
+    if (y < y1) xb = x0 + (x1 - x0) * (y - y0) / (y1 - y0);
+    else xb = y2 == y1 ? x1 : x1 + (x2 - x1) * (y - y1) / (y2 - y1);
+    span(xa, xb, y);
+  }
+}
+
+// Angles are 0..255 for a full turn, counter-clockwise from 3 o'clock
+void U8G2::drawArc(int x0, int y0, int rad, uint8_t start, uint8_t end) {
+  int sweep = (end - start) & 0xFF;
+  if (sweep == 0) sweep = 256;
+  int steps = std::max(8, (int)(2 * PI * rad * sweep / 256) * 2);
+  int lastX = INT32_MIN, lastY = INT32_MIN;
+  for (int i = 0; i <= steps; i++) {
+    double a = (start + (double)sweep * i / steps) * 2 * PI / 256;
+    int x = x0 + (int)lround(rad * cos(a));
+    int y = y0 - (int)lround(rad * sin(a));
+    if (x == lastX && y == lastY) continue;  // xor mode must not hit a pixel twice
+    pixel(x, y, u.draw_color);
+    lastX = x;
+    lastY = y;
+  }
+}
+
+// XBM rows are LSB first; clear bits draw the other colour unless the bitmap mode is transparent
+void U8G2::drawXBM(int x, int y, int w, int h, const uint8_t* bitmap) {
+  int stride = (w + 7) / 8;
+  uint8_t background = u.draw_color == 0 ? 1 : 0;
+  for (int row = 0; row < h; row++) {
+    for (int col = 0; col < w; col++) {
+      bool set = bitmap[row * stride + col / 8] & (1 << (col & 7));
+      if (set) pixel(x + col, y + row, u.draw_color);
+      else if (!u.bitmap_transparency && u.draw_color < 2) pixel(x + col, y + row, background);
+    }
+  }
+}
+
+// === Text ===
+int8_t U8G2::getAscent() { return 7 * fontOrDefault(u.font)[1]; }
+int8_t U8G2::getDescent() { return -fontOrDefault(u.font)[1]; }
+
+// The 5x7 cell sits on the baseline at y; the descender row is drawn at y
+int U8G2::drawGlyph(int x, int y, uint32_t code) {
+  const uint8_t* font = fontOrDefault(u.font);
+  int advance = font[0], scale = font[1], bold = font[2];
+  const uint8_t* columns = glyphFor(code);
+  uint8_t background = u.draw_color == 0 ? 1 : 0;
+  bool solid = u.font_mode == 0 && u.draw_color < 2;
+
+  for (int col = 0; col < GLYPH_COLUMNS + bold; col++) {
+    uint8_t bits = col < GLYPH_COLUMNS ? columns[col] : 0;
+    if (bold && col > 0) bits |= columns[col - 1];
+    for (int row = 0; row < 8; row++) {
+      bool set = bits & (1 << row);
+      if (!set && !solid) continue;
+      uint8_t color = set ? u.draw_color : background;
+      for (int sy = 0; sy < scale; sy++) {
+        for (int sx = 0; sx < scale; sx++) {
+          pixel(x + col * scale + sx, y - (7 - row) * scale + sy, color);
+        }
+      }
+    }
+  }
+  return advance;
+}
+
+int U8G2::drawText(int x, int y, const char* text, bool utf8) {
+  int start = x;
+  while (*text) x += drawGlyph(x, y, nextCodepoint(text, utf8));
+  return x - start;
+}
+
+int U8G2::drawStr(int x, int y, const char* text) { return drawText(x, y, text, false); }
+int U8G2::drawUTF8(int x, int y, const char* text) { return drawText(x, y, text, true); }
+
+int U8G2::getStrWidth(const char* text) {
+  return strlen(text) * fontOrDefault(u.font)[0];
+}
+
+int U8G2::getUTF8Width(const char* text) {
+  int width = 0;
+  while (*text) {
+    nextCodepoint(text, true);
+    width += fontOrDefault(u.font)[0];
+  }
+  return width;
+}
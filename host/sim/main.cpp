@@ -0,0 +1,250 @@
+// desksim: runs the firmware against a scripted session on the virtual clock
+// and prints a replay report.
+//
+//   desksim [--seed N] [--out DIR] [--echo] [--pass-cost-us N] session.sim
+//
+// Session lines are "<time> <command> [args]"; time is absolute ms or +ms after
+// the previous line, '#' starts a comment.
+//
+//   connect [mtu]        disconnect           mtu N
+//   write TEXT           writehex HEX         serial TEXT
+//   turn 1|2 DETENTS     press 1|2            release 1|2
+//   click 1|2            hold 1|2 MS          pir 0|1
+//   accel X Y Z          light ADC            climate T H
+//   snap NAME            end
+#include "DeskCompanionCode.ino.cpp"
+#include "HostSim.h"
+#include <chrono>
+#include <fstream>
+#include <sstream>
+
+namespace {
+
+const uint64_t CLICK_US = 80000;
+const uint64_t END_GRACE_US = 1000000;  // run on after the last line without "end"
+
+struct Command {
+  uint64_t timeUs;
+  int line;
+  std::string name;
+  std::string args;
+};
+
+struct Options {
+  uint32_t seed = 1;
+  std::string outDir = ".";
+  bool echo = false;
+  uint64_t passCostUs = 200;  // stands in for the work a pass does on the device
+  std::string script;
+};
+
+[[noreturn]] void fail(const std::string& script, int line, const std::string& message) {
+  fprintf(stderr, "%s:%d: %s\n", script.c_str(), line, message.c_str());
+  exit(2);
+}
+
+std::vector<Command> parseScript(const std::string& path) {
+  std::ifstream in(path);
+  if (!in) {
+    fprintf(stderr, "desksim: cannot open %s\n", path.c_str());
+    exit(2);
+  }
+
+  std::vector<Command> commands;
+  uint64_t lastUs = 0;
+  std::string text;
+  for (int line = 1; std::getline(in, text); line++) {
+    size_t hash = text.find('#');
+    if (hash != std::string::npos) text.erase(hash);
+    std::istringstream fields(text);
+    std::string when, name;
+    if (!(fields >> when)) continue;
+    if (!(fields >> name)) fail(path, line, "missing command");
+
+    bool relative = when[0] == '+';
+    char* end;
+    double ms = strtod(when.c_str() + relative, &end);
+    if (*end || ms < 0) fail(path, line, "bad time '" + when + "'");
+    uint64_t timeUs = (relative ? lastUs : 0) + (uint64_t)llround(ms * 1000);
+    if (timeUs < lastUs) fail(path, line, "time goes backwards");
+    lastUs = timeUs;
+
+    std::string args;
+    std::getline(fields >> std::ws, args);
+    commands.push_back({ timeUs, line, name, args });
+  }
+  return commands;
+}
+
+int buttonPin(const Command& c, const std::string& script) {
+  int which = atoi(c.args.c_str());
+  if (which == 1) return ENCODER1_BTN;
+  if (which == 2) return ENCODER2_BTN;
+  fail(script, c.line, "encoder must be 1 or 2");
+}
+
+std::vector<uint8_t> parseHex(const Command& c, const std::string& script) {
+  std::vector<uint8_t> bytes;
+  std::string digits;
+  for (char ch : c.args) {
+    if (isxdigit((unsigned char)ch)) digits += ch;
+    else if (!isspace((unsigned char)ch)) fail(script, c.line, "bad hex");
+  }
+  if (digits.size() % 2) fail(script, c.line, "odd number of hex digits");
+  for (size_t i = 0; i < digits.size(); i += 2) bytes.push_back(strtoul(digits.substr(i, 2).c_str(), nullptr, 16));
+  return bytes;
+}
+
+// Runs in interrupt context at the command's time
+void run(const Command& c, const Options& options) {
+  const std::string& script = options.script;
+  std::istringstream args(c.args);
+
+  if (c.name == "connect") {
+    int mtu = 23;
+    args >> mtu;
+    hostsim::bleConnect(mtu);
+  } else if (c.name == "disconnect") {
+    hostsim::bleDisconnect();
+  } else if (c.name == "mtu") {
+    int mtu;
+    if (!(args >> mtu)) fail(script, c.line, "mtu needs a value");
+    hostsim::bleSetMtu(mtu);
+  } else if (c.name == "write") {
+    hostsim::bleWrite(c.args);
+  } else if (c.name == "writehex") {
+    hostsim::bleWrite(parseHex(c, script));
+  } else if (c.name == "serial") {
+    hostsim::serialInput(c.args + "\n");
+  } else if (c.name == "turn") {
+    int which, detents;
+    if (!(args >> which >> detents) || (which != 1 && which != 2)) fail(script, c.line, "turn 1|2 DETENTS");
+    hostsim::turnEncoder(which == 1 ? ENCODER1_A : ENCODER2_A, detents);
+  } else if (c.name == "press") {
+    hostsim::setPin(buttonPin(c, script), LOW);
+  } else if (c.name == "release") {
+    hostsim::setPin(buttonPin(c, script), HIGH);
+  } else if (c.name == "click" || c.name == "hold") {
+    int pin = buttonPin(c, script);
+    uint64_t holdUs = CLICK_US;
+    if (c.name == "hold") {
+      int which, ms;
+      if (!(args >> which >> ms)) fail(script, c.line, "hold 1|2 MS");
+      holdUs = (uint64_t)ms * 1000;
+    }
+    hostsim::setPin(pin, LOW);
+    hostsim::at(hostsim::nowUs() + holdUs, [pin]() { hostsim::setPin(pin, HIGH); });
+  } else if (c.name == "pir") {
+    hostsim::setPin(PIR_PIN, atoi(c.args.c_str()) ? HIGH : LOW);
+  } else if (c.name == "accel") {
+    float x, y, z;
+    if (!(args >> x >> y >> z)) fail(script, c.line, "accel X Y Z");
+    hostsim::setAcceleration(x, y, z);
+  } else if (c.name == "light") {
+    hostsim::setAnalog(LDR_PIN, atoi(c.args.c_str()));
+  } else if (c.name == "climate") {
+    float t, h;
+    if (!(args >> t >> h)) fail(script, c.line, "climate T H");
+    hostsim::setClimate(t, h);
+  } else if (c.name == "snap") {
+    std::string path = options.outDir + "/" + (c.args.empty() ? "frame" : c.args) + ".pbm";
+    if (!hostsim::writePbm(path, hostsim::panel())) fail(script, c.line, "cannot write " + path);
+  } else if (c.name == "end") {
+    hostsim::requestStop();
+  } else {
+    fail(script, c.line, "unknown command '" + c.name + "'");
+  }
+}
+
+std::string printable(const std::vector<uint8_t>& value) {
+  bool text = !value.empty() && value[0] != BLE_FRAME_MAGIC;
+  for (uint8_t b : value) text = text && b >= 0x20 && b < 0x7F;
+  if (text) return std::string(value.begin(), value.end());
+
+  std::string hex;
+  char byte[4];
+  for (uint8_t b : value) {
+    snprintf(byte, sizeof(byte), "%02x ", b);
+    hex += byte;
+  }
+  if (!hex.empty()) hex.pop_back();
+  return hex;
+}
+
+Options parseOptions(int argc, char** argv) {
+  Options options;
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if (arg == "--seed" && i + 1 < argc) options.seed = strtoul(argv[++i], nullptr, 0);
+    else if (arg == "--out" && i + 1 < argc) options.outDir = argv[++i];
+    else if (arg == "--pass-cost-us" && i + 1 < argc) options.passCostUs = strtoull(argv[++i], nullptr, 0);
+    else if (arg == "--echo") options.echo = true;
+    else if (options.script.empty() && arg[0] != '-') options.script = arg;
+    else {
+      fprintf(stderr, "usage: desksim [--seed N] [--out DIR] [--echo] [--pass-cost-us N] session.sim\n");
+      exit(2);
+    }
+  }
+  if (options.script.empty()) {
+    fprintf(stderr, "usage: desksim [--seed N] [--out DIR] [--echo] [--pass-cost-us N] session.sim\n");
+    exit(2);
+  }
+  return options;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  Options options = parseOptions(argc, argv);
+  std::vector<Command> commands = parseScript(options.script);
+
+  hostsim::seed(options.seed);
+  hostsim::setSerialEcho(options.echo);
+  hostsim::wireAdxlInt1(ADXL_INT_PIN);
+  hostsim::wireDht11(DHT_PIN);
+
+  uint64_t lastUs = 0;
+  bool hasEnd = false;
+  for (const Command& c : commands) {
+    hostsim::at(c.timeUs, [c, &options]() { run(c, options); });
+    lastUs = c.timeUs;
+    hasEnd = hasEnd || c.name == "end";
+  }
+  if (!hasEnd) hostsim::at(lastUs + END_GRACE_US, hostsim::requestStop);
+
+  setup();
+
+  // Host time is only counted for passes that hand a frame to the display task
+  uint64_t passes = 0, framePasses = 0, frameNsTotal = 0, frameNsMax = 0;
+  while (!hostsim::stopRequested()) {
+    unsigned long framesBefore = flushFrameCount;
+    auto start = std::chrono::steady_clock::now();
+    loop();
+    uint64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+    passes++;
+    if (flushFrameCount != framesBefore) {
+      framePasses++;
+      frameNsTotal += ns;
+      frameNsMax = std::max(frameNsMax, ns);
+    }
+    hostsim::advance(options.passCostUs);
+  }
+
+  double seconds = hostsim::nowUs() / 1e6;
+  printf("replay         %s (seed %u)\n", options.script.c_str(), options.seed);
+  printf("virtual time   %.3f s\n", seconds);
+  printf("loop passes    %llu\n", (unsigned long long)passes);
+  printf("frames         %lu (%.1f fps)\n", flushFrameCount, seconds > 0 ? flushFrameCount / seconds : 0.0);
+  printf("bytes flushed  %lu (%.1f B/frame)\n", flushBytesTotal,
+         flushFrameCount ? (double)flushBytesTotal / flushFrameCount : 0.0);
+  printf("panel writes   %llu spans, %llu bytes\n", (unsigned long long)hostsim::panelTileWrites(),
+         (unsigned long long)hostsim::panelBytesWritten());
+  printf("host ns/frame  avg %llu, max %llu\n", (unsigned long long)(framePasses ? frameNsTotal / framePasses : 0),
+         (unsigned long long)frameNsMax);
+  printf("tones          %zu\n", hostsim::tones().size());
+
+  const auto& notified = hostsim::bleNotifications();
+  printf("notifications  %zu\n", notified.size());
+  for (const auto& n : notified) printf("  %9.3f s  %s\n", n.timeUs / 1e6, printable(n.value).c_str());
+  return 0;
+}
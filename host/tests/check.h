@@ -0,0 +1,59 @@
+// Minimal checks for the host tests: a failed check prints where and why and
+// the run carries on; main() returns checkResult() so ctest sees the failures.
+#pragma once
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+namespace hosttest {
+
+inline int& failures() {
+  static int count = 0;
+  return count;
+}
+
+inline bool check(bool ok, const char* expression, const char* file, int line) {
+  if (!ok) {
+    fprintf(stderr, "%s:%d: check failed: %s\n", file, line, expression);
+    failures()++;
+  }
+  return ok;
+}
+
+template <class T> std::string describe(const T& value) {
+  if constexpr (std::is_same_v<T, bool>) return value ? "true" : "false";
+  else if constexpr (std::is_integral_v<T> || std::is_enum_v<T>) return std::to_string((long long)value);
+  else if constexpr (std::is_floating_point_v<T>) return std::to_string(value);
+  else return "\"" + std::string(value) + "\"";
+}
+
+template <class A, class B>
+bool checkEqual(const A& actual, const B& expected, const char* expression, const char* file, int line) {
+  bool ok;
+  if constexpr (std::is_convertible_v<A, const char*> && std::is_convertible_v<B, const char*>) {
+    ok = strcmp(actual, expected) == 0;
+  } else {
+    ok = actual == expected;
+  }
+  if (!ok) {
+    fprintf(stderr, "%s:%d: check failed: %s\n  actual   %s\n  expected %s\n", file, line, expression,
+            describe(actual).c_str(), describe(expected).c_str());
+    failures()++;
+  }
+  return ok;
+}
+
+inline int checkResult(const char* name) {
+  if (failures()) {
+    fprintf(stderr, "%s: %d check(s) failed\n", name, failures());
+    return 1;
+  }
+  printf("%s: ok\n", name);
+  return 0;
+}
+
+}  // namespace hosttest
+
+#define CHECK(condition) hosttest::check((condition), #condition, __FILE__, __LINE__)
+#define CHECK_EQ(actual, expected) hosttest::checkEqual((actual), (expected), #actual " == " #expected, __FILE__, __LINE__)
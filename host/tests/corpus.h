@@ -0,0 +1,45 @@
+// Message corpora for the host tests and benchmarks: one message per line,
+// '#' lines are comments, and \n, \\ and \xNN escape bytes a line can't hold.
+#pragma once
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace hosttest {
+
+inline std::string unescape(const std::string& line) {
+  std::string out;
+  for (size_t i = 0; i < line.size(); i++) {
+    if (line[i] != '\\' || i + 1 == line.size()) {
+      out += line[i];
+    } else if (line[i + 1] == 'n') {
+      out += '\n';
+      i++;
+    } else if (line[i + 1] == 'x' && i + 3 < line.size()) {
+      out += (char)strtoul(line.substr(i + 2, 2).c_str(), nullptr, 16);
+      i += 3;
+    } else {
+      out += line[++i];
+    }
+  }
+  return out;
+}
+
+inline std::vector<std::string> loadCorpus(const std::string& path) {
+  std::ifstream in(path);
+  if (!in) {
+    fprintf(stderr, "cannot read corpus %s\n", path.c_str());
+    exit(2);
+  }
+  std::vector<std::string> messages;
+  std::string line;
+  while (std::getline(in, line)) {
+    if (line.empty() || line[0] == '#') continue;
+    messages.push_back(unescape(line));
+  }
+  return messages;
+}
+
+}  // namespace hosttest
@@ -0,0 +1,142 @@
+// DHT11 reads by edge capture: the readings published to the faces follow the
+// climate, a sensor that doesn't answer publishes nothing, and the loop answers
+// input as quickly while a read is in progress as at any other time.
+//
+//   dht_test [--seconds N]
+#include "DeskCompanionCode.ino.cpp"
+#include "HostSim.h"
+#include "check.h"
+
+namespace {
+
+const uint64_t PASS_COST_US = 200;  // as desksim
+const uint64_t MS = 1000;
+const uint64_t PROBE_US = 20;
+const uint64_t GIVE_UP_US = 50 * MS;
+
+void runUntil(uint64_t timeUs) {
+  while (hostsim::nowUs() < timeUs) {
+    loop();
+    hostsim::advance(PASS_COST_US);
+  }
+}
+
+// === Readings ===
+void testReadings() {
+  hostsim::setClimate(23.0, 41.0);
+  runUntil(hostsim::nowUs() + tempReadInterval * MS);
+  CHECK(fabs(temperature - 23.0) < 0.05 && fabs(humidity - 41.0) < 0.05);
+
+  hostsim::setClimate(-3.4, 87.6);
+  runUntil(hostsim::nowUs() + tempReadInterval * MS);
+  CHECK(fabs(temperature + 3.4) < 0.05 && fabs(humidity - 87.6) < 0.05);
+
+  // No answer: the last reading stays and no sample is counted
+  uint32_t samples = dhtSampleCount;
+  size_t replies = hostsim::dhtReplies().size();
+  hostsim::setClimate(NAN, NAN);
+  runUntil(hostsim::nowUs() + 2 * tempReadInterval * MS);
+  CHECK_EQ(dhtSampleCount, samples);
+  CHECK_EQ(hostsim::dhtReplies().size(), replies);
+  CHECK(fabs(temperature + 3.4) < 0.05);
+
+  hostsim::setClimate(22.0, 45.0);
+  runUntil(hostsim::nowUs() + tempReadInterval * MS);
+  CHECK_EQ(dhtSampleCount, samples + 1);
+}
+
+// === Input Latency ===
+struct Latency {
+  uint64_t turnUs;
+  uint64_t us;
+};
+std::vector<Latency> latencies;
+
+// Polls from interrupt context until the loop has taken the detent turned at turnUs
+void probe(uint64_t turnUs, int position) {
+  uint64_t now = hostsim::nowUs();
+  if (encoder1Pos == position || now - turnUs > GIVE_UP_US) {
+    latencies.push_back({ turnUs, now - turnUs });
+    return;
+  }
+  hostsim::at(now + PROBE_US, [turnUs, position]() { probe(turnUs, position); });
+}
+
+const uint64_t BUCKETS_US[] = { 100, 200, 400, 800, 1600, UINT64_MAX };
+const int BUCKET_COUNT = sizeof(BUCKETS_US) / sizeof(BUCKETS_US[0]);
+
+int bucketOf(uint64_t us) {
+  int b = 0;
+  while (us >= BUCKETS_US[b]) b++;
+  return b;
+}
+
+// One detent every 2-4 ms, so every read has turns landing in its start pulse and reply
+void testInputLatency(uint64_t seconds) {
+  uint64_t start = hostsim::nowUs();
+  uint64_t end = start + seconds * 1000 * MS;
+  size_t firstRead = hostsim::dhtReplies().size();
+  uint32_t jitter = 1;
+  int position = encoder1Pos;
+  for (uint64_t t = start + 1000; t < end; t += 2 * MS + (jitter >> 8) % (2 * MS)) {
+    jitter = jitter * 1664525u + 1013904223u;
+    int target = ++position;
+    hostsim::at(t, [t, target]() {
+      hostsim::turnEncoder(ENCODER1_A, 1);
+      probe(t, target);
+    });
+  }
+  runUntil(end + GIVE_UP_US);
+
+  // Start pulse to end of capture, around each reply
+  const std::vector<uint64_t>& replies = hostsim::dhtReplies();
+  auto duringRead = [&](uint64_t turnUs) {
+    for (size_t i = firstRead; i < replies.size(); i++) {
+      if (turnUs + DHT_START_MS * MS >= replies[i] && turnUs <= replies[i] + DHT_FRAME_MS * MS) return true;
+    }
+    return false;
+  };
+
+  uint32_t histogram[2][BUCKET_COUNT] = {};
+  uint64_t worst[2] = {};
+  size_t counts[2] = {};
+  for (const Latency& l : latencies) {
+    int reading = duringRead(l.turnUs);
+    histogram[reading][bucketOf(l.us)]++;
+    worst[reading] = std::max(worst[reading], l.us);
+    counts[reading]++;
+  }
+
+  printf("input latency over %llu s, %zu DHT reads\n", (unsigned long long)seconds, replies.size() - firstRead);
+  printf("%-12s %10s %10s\n", "latency", "otherwise", "reading");
+  for (int b = 0; b < BUCKET_COUNT; b++) {
+    char label[16];
+    if (BUCKETS_US[b] == UINT64_MAX) snprintf(label, sizeof(label), ">= %llu us", (unsigned long long)BUCKETS_US[b - 1]);
+    else snprintf(label, sizeof(label), "< %llu us", (unsigned long long)BUCKETS_US[b]);
+    printf("%-12s %10u %10u\n", label, histogram[0][b], histogram[1][b]);
+  }
+  printf("%-12s %10llu %10llu\n", "worst us", (unsigned long long)worst[0], (unsigned long long)worst[1]);
+
+  CHECK(replies.size() - firstRead >= seconds * 1000 / tempReadInterval - 1);
+  CHECK(counts[1] >= 50);
+  CHECK(worst[0] < 1000 && worst[1] < 1000);
+  CHECK(worst[1] <= worst[0] + PROBE_US);
+  CHECK_EQ(encoder1Pos, position);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  uint64_t seconds = 60;
+  if (argc > 2 && !strcmp(argv[1], "--seconds")) seconds = std::max(10, atoi(argv[2]));
+
+  hostsim::seed(1);
+  hostsim::wireDht11(DHT_PIN);
+  hostsim::setPin(PIR_PIN, HIGH);  // someone at the desk, so the device stays awake
+  setup();
+  runUntil(1000 * MS);
+
+  testReadings();
+  testInputLatency(seconds);
+  return hosttest::checkResult("dht_test");
+}
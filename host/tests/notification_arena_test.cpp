@@ -0,0 +1,134 @@
+// Notification arena under a long random add/evict workload: the text blocks
+// stay packed in ring order, evictions only happen when the arena is really
+// full, and every visible notification reads back what was added.
+//
+//   notification_arena_test [--seed N] [--operations N]
+#include "DeskCompanionCode.ino.cpp"
+#include "HostSim.h"
+#include "check.h"
+#include <deque>
+
+namespace {
+
+const size_t MAX_BLOCK = NOTIF_APP_MAX + NOTIF_TITLE_MAX + NOTIF_CONTENT_MAX;
+
+struct Entry {
+  std::string app, title, content;
+};
+
+uint32_t randomState;
+
+uint32_t nextRandom() {
+  randomState ^= randomState << 13;
+  randomState ^= randomState >> 17;
+  randomState ^= randomState << 5;
+  return randomState;
+}
+
+std::string randomText(size_t maxLength) {
+  std::string text(nextRandom() % (maxLength + 1), ' ');
+  for (char& c : text) c = 'a' + nextRandom() % 26;
+  return text;
+}
+
+const Notification& slot(int i) {
+  return notifications[(notificationHead + i) % MAX_NOTIFICATIONS];
+}
+
+size_t liveBytes() {
+  size_t bytes = 0;
+  for (int i = 0; i < notificationSlots; i++) bytes += slot(i).length;
+  return bytes;
+}
+
+// Each block starts where the previous one ended, or at 0 once when the fill wraps
+bool packedInRingOrder() {
+  int wraps = 0;
+  for (int i = 1; i < notificationSlots; i++) {
+    const Notification& a = slot(i - 1);
+    const Notification& b = slot(i);
+    if (b.offset == a.offset + a.length) continue;
+    if (b.offset != 0 || ++wraps > 1) return false;
+  }
+  if (notificationSlots == 0) return true;
+  // After a wrap the newest block must still end before the oldest begins
+  const Notification& oldest = slot(0);
+  const Notification& newest = slot(notificationSlots - 1);
+  if (notificationArenaTail != newest.offset + newest.length) return false;
+  return wraps ? notificationArenaTail <= oldest.offset : notificationArenaTail <= NOTIF_ARENA_SIZE;
+}
+
+// The newest notificationCount entries of the model, oldest first
+bool matchesModel(const std::deque<Entry>& model) {
+  if ((size_t)notificationCount > model.size()) return false;
+  size_t first = model.size() - notificationCount;
+  for (int i = 0; i < notificationCount; i++) {
+    const Notification& n = notificationAt(i);
+    const Entry& e = model[first + i];
+    if (e.app != notificationApp(n) || e.title != notificationTitle(n) || e.content != notificationContent(n)) return false;
+  }
+  return true;
+}
+
+void run(uint32_t seed, long operations) {
+  randomState = seed ? seed : 1;
+  std::deque<Entry> model;
+  const char* apps[] = { "Mail", "Chat", "Calendar", "News", "Bank", "Weather" };
+  size_t worstWaste = 0;
+  long spaceEvictions = 0;
+  showNotificationPopup = true;  // one popup is already up, so adds don't schedule more
+
+  for (long op = 0; op < operations; op++) {
+    // Phases of short messages (the slot cap evicts) and long ones (the arena does)
+    bool longPhase = (op / 5000) % 2;
+    Entry e = { apps[nextRandom() % 6], "t" + std::to_string(nextRandom() % 24),
+                randomText(longPhase ? NOTIF_CONTENT_MAX - 1 : 24) };
+    if (longPhase) e.title += randomText(NOTIF_TITLE_MAX - 4);
+
+    int slotsBefore = notificationSlots;
+    addNotification(e.app.c_str(), e.title.c_str(), e.content.c_str());
+
+    for (auto it = model.begin(); it != model.end(); ++it) {
+      if (it->app == e.app && it->title == e.title) {
+        model.erase(it);
+        break;
+      }
+    }
+    model.push_back(e);
+    if (model.size() > MAX_NOTIFICATIONS) model.pop_front();
+
+    if (!CHECK(packedInRingOrder()) || !CHECK(matchesModel(model))) {
+      fprintf(stderr, "  after operation %ld (seed %u)\n", op, seed);
+      return;
+    }
+
+    // Evicted for space rather than for a descriptor: only the tail left unused
+    // by the wrap and the gap the new block didn't fit into may be free
+    bool evictedForSpace = notificationSlots <= slotsBefore && slotsBefore < MAX_NOTIFICATIONS;
+    if (evictedForSpace) {
+      spaceEvictions++;
+      size_t waste = NOTIF_ARENA_SIZE - liveBytes();
+      worstWaste = std::max(worstWaste, waste);
+      if (!CHECK(waste < 2 * MAX_BLOCK)) {
+        fprintf(stderr, "  %zu bytes free after evicting at operation %ld (seed %u)\n", waste, op, seed);
+        return;
+      }
+    }
+  }
+  CHECK(spaceEvictions > 0);
+  printf("%ld operations, %ld evictions for space, at most %zu of %d bytes free after one\n", operations,
+         spaceEvictions, worstWaste, NOTIF_ARENA_SIZE);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  uint32_t seed = 1;
+  long operations = 200000;
+  for (int i = 1; i + 1 < argc; i += 2) {
+    if (!strcmp(argv[i], "--seed")) seed = strtoul(argv[i + 1], nullptr, 0);
+    else if (!strcmp(argv[i], "--operations")) operations = atol(argv[i + 1]);
+  }
+  run(seed, operations);
+  return hosttest::checkResult("notification_arena_test");
+}
@@ -0,0 +1,70 @@
+// Outbound command coalescing: encoder turns on the music face reach the phone
+// as one notification per flush window, carrying every detent turned, including
+// several detents read by a single encoder poll.
+#include "DeskCompanionCode.ino.cpp"
+#include "HostSim.h"
+#include "check.h"
+
+namespace {
+
+const uint64_t PASS_COST_US = 200;  // as desksim
+const uint64_t MS = 1000;
+
+void runUntil(uint64_t timeUs) {
+  while (hostsim::nowUs() < timeUs) {
+    loop();
+    hostsim::advance(PASS_COST_US);
+  }
+}
+
+// Text notifications sent since index 'from'
+std::vector<std::string> sentSince(size_t from) {
+  std::vector<std::string> sent;
+  const auto& all = hostsim::bleNotifications();
+  for (size_t i = from; i < all.size(); i++) sent.push_back(std::string(all[i].value.begin(), all[i].value.end()));
+  return sent;
+}
+
+// Turns of encoder 1 at the given offsets (ms) from now, then waits out the flush window
+std::vector<std::string> skips(const std::vector<std::pair<uint64_t, int>>& turns) {
+  size_t from = hostsim::bleNotifications().size();
+  uint64_t start = hostsim::nowUs();
+  for (const auto& turn : turns) {
+    int detents = turn.second;
+    hostsim::at(start + turn.first * MS, [detents]() { hostsim::turnEncoder(ENCODER1_A, detents); });
+  }
+  runUntil(start + (turns.back().first + 1000) * MS);
+  return sentSince(from);
+}
+
+void testSkips() {
+  // One detent stays a bare command
+  CHECK(skips({ { 0, 1 } }) == std::vector<std::string>({ "MUSIC_NEXT" }));
+  CHECK(skips({ { 0, -1 } }) == std::vector<std::string>({ "MUSIC_PREV" }));
+
+  // A fast spin the loop reads as one event of several detents
+  CHECK(skips({ { 0, 3 } }) == std::vector<std::string>({ "MUSIC_NEXT:3" }));
+  CHECK(skips({ { 0, -4 } }) == std::vector<std::string>({ "MUSIC_PREV:4" }));
+
+  // Turns within one window add up, back and forth
+  CHECK(skips({ { 0, 2 }, { 40, 1 }, { 90, 3 } }) == std::vector<std::string>({ "MUSIC_NEXT:6" }));
+  CHECK(skips({ { 0, 3 }, { 50, -5 } }) == std::vector<std::string>({ "MUSIC_PREV:2" }));
+  CHECK(skips({ { 0, 2 }, { 50, -2 } }).empty());  // cancelled out
+
+  // A turn after the window closed opens the next one
+  CHECK(skips({ { 0, 2 }, { 400, 5 } }) == std::vector<std::string>({ "MUSIC_NEXT:2", "MUSIC_NEXT:5" }));
+}
+
+}  // namespace
+
+int main() {
+  hostsim::seed(1);
+  hostsim::setPin(PIR_PIN, HIGH);  // someone at the desk, so the device stays awake
+  setup();
+  hostsim::bleConnect(247);
+  runUntil(2000 * MS);
+  currentState = MUSIC;
+
+  testSkips();
+  return hosttest::checkResult("outbound_test");
+}
@@ -0,0 +1,192 @@
+// Frame pacer on the virtual clock: nextWakeTime() decisions for hand-set
+// states, then the whole firmware looping the way the device does, checking
+// how often it wakes, how quickly it answers input and that animations run off
+// the scheduler rather than the redraw rate.
+#include "DeskCompanionCode.ino.cpp"
+#include "HostSim.h"
+#include "check.h"
+
+namespace {
+
+const uint64_t PASS_COST_US = 200;  // as desksim
+const uint64_t MS = 1000;
+
+uint64_t passes = 0;
+
+// loop() as the Arduino core runs it; paceFrame() blocks on the virtual clock
+template <class Watch> void runUntil(uint64_t timeUs, Watch watch) {
+  while (hostsim::nowUs() < timeUs) {
+    loop();
+    hostsim::advance(PASS_COST_US);
+    passes++;
+    watch();
+  }
+}
+
+void runUntil(uint64_t timeUs) {
+  runUntil(timeUs, []() {});
+}
+
+// === Decisions ===
+void testDecisions() {
+  unsigned long now = millis();
+  uint8_t tasks = taskCount;
+  taskCount = 0;  // scheduled work aside, so each case decides the wake on its own
+  long quiet = (long)(nextWakeTime(now) - now);
+  CHECK(quiet > 0 && quiet <= (long)PACER_MAX_SLEEP);
+
+  // A face with dirty dependencies draws on the next pass
+  invalidateRender(DEP_INPUT);
+  CHECK_EQ(nextWakeTime(now), now);
+
+  // ...unless an expression covers it: then only the expression's next frame is due
+  eyes.happy();
+  CHECK_EQ(nextWakeTime(now), now + EYE_FRAME_INTERVAL);
+  eyes.cancel();
+  renderDirty = 0;
+
+  // A held button wakes the loop when it turns into a long press
+  buttons[1] = { true, false, (uint32_t)(now - 480), (uint32_t)(now - 480) };
+  CHECK_EQ(nextWakeTime(now), now + LONG_PRESS_TIME - 480);
+
+  // ...and once the debounce window of an edge has passed
+  buttons[1] = { false, false, 0, (uint32_t)(now - 10) };
+  CHECK_EQ(nextWakeTime(now), now + BUTTON_DEBOUNCE - 10);
+  buttons[1] = { false, false, 0, 0 };
+
+  // A countdown about to finish
+  bool wasRunning = timerRunning;
+  TimerType wasType = selectedTimerType;
+  unsigned long wasStart = timerStartTime, wasDuration = timerDuration, wasElapsed = timerElapsed;
+  timerRunning = true;
+  selectedTimerType = COUNTDOWN;
+  timerStartTime = now - 1000;
+  timerDuration = 1030;
+  timerElapsed = 0;
+  CHECK_EQ(nextWakeTime(now), now + 30);
+  timerRunning = wasRunning;
+  selectedTimerType = wasType;
+  timerStartTime = wasStart;
+  timerDuration = wasDuration;
+  timerElapsed = wasElapsed;
+
+  // Asleep: only interrupts and BLE have work
+  isAsleep = true;
+  AppState wasState = currentState;
+  currentState = SLEEP;
+  CHECK_EQ(nextWakeTime(now), now + PACER_ASLEEP_MAX);
+  isAsleep = false;
+  currentState = wasState;
+
+  // Queued input is handled on the next pass
+  enqueueInputEvent({ 0, INPUT_ROTATE, 1, (uint32_t)now });
+  CHECK_EQ(nextWakeTime(now), now);
+  InputEvent event;
+  while (popInputEvent(event)) {}
+  taskCount = tasks;
+}
+
+// === Whole Firmware ===
+// Idle eyes wake for the tilt samples, the LDR, blinks and the PACER_MAX_SLEEP cap only
+void testIdleRate() {
+  uint64_t start = hostsim::nowUs();
+  uint64_t passesBefore = passes;
+  runUntil(start + 10000 * MS);
+  double perSecond = (passes - passesBefore) / ((hostsim::nowUs() - start) / 1e6);
+  printf("idle: %.1f passes/s\n", perSecond);
+  CHECK(perSecond < 30);
+}
+
+// An expression draws one frame per EYE_FRAME_INTERVAL and the loop sleeps between
+// them, even when the face under it goes stale: here it is picked up as the phone connects
+void testExpressionRate() {
+  uint64_t start = hostsim::nowUs();
+  uint64_t passesBefore = passes;
+  uint64_t endUs = 0, expressionPasses = 0;
+  hostsim::bleConnect(247);                 // eyes.excited()
+  hostsim::setAcceleration(0.4, 0.1, 0.9);  // then eyes.happy() and a new tilt for the face
+  runUntil(start + 4000 * MS, [&]() {
+    if (endUs || connectFeedbackPending || eyes.isAnimating()) return;
+    endUs = hostsim::nowUs();
+    expressionPasses = passes - passesBefore;
+  });
+  CHECK(endUs > start);
+  CHECK(fabs(tiltX) > 0.2);
+  double expressionMs = (endUs - start) / 1000.0;
+  printf("expression: %llu passes over %.0f ms\n", (unsigned long long)expressionPasses, expressionMs);
+  CHECK(expressionPasses < 1.5 * expressionMs / EYE_FRAME_INTERVAL + 20);
+}
+
+// A button edge ends the pacer's sleep at once; a hold turns into a long press on
+// time. Checked from interrupt context, while the loop waits for its next wake.
+void testInputLatency() {
+  uint64_t pressUs = hostsim::nowUs() + 37 * MS;  // somewhere in the middle of a sleep
+  hostsim::at(pressUs, []() { hostsim::setPin(ENCODER2_BTN, LOW); });
+  hostsim::at(pressUs + 1 * MS, []() { CHECK(buttons[1].pressed); });
+  hostsim::at(pressUs + (LONG_PRESS_TIME - 1) * MS, []() { CHECK(!buttons[1].longPressFired); });
+  hostsim::at(pressUs + (LONG_PRESS_TIME + 1) * MS, []() { CHECK(buttons[1].longPressFired); });
+  hostsim::at(pressUs + 700 * MS, []() { hostsim::setPin(ENCODER2_BTN, HIGH); });
+  hostsim::at(pressUs + 701 * MS, []() { CHECK(!buttons[1].pressed); });
+  runUntil(pressUs + 1000 * MS);
+}
+
+// === Scheduled Animation ===
+// The music note turns once per frameInterval while playing, whether the face
+// redraws for it alone or every 5 ms for other reasons, and stops when paused
+void testMusicNote() {
+  currentState = MUSIC;
+  applyMusicState(true, 0);
+  for (int redrawEveryMs : { 0, 5 }) {
+    uint64_t start = hostsim::nowUs();
+    if (redrawEveryMs) {
+      for (uint64_t t = start; t < start + 1400 * MS; t += redrawEveryMs * MS) {
+        hostsim::at(t, []() { invalidateRender(DEP_INPUT); });
+      }
+    }
+    // Frames shown at either end of 1.2 s, read from interrupt context
+    static int first, last;
+    hostsim::at(start + 100 * MS, []() { first = currentFrame; });
+    hostsim::at(start + 1300 * MS, []() { last = currentFrame; });
+    runUntil(start + 1400 * MS);
+    CHECK_EQ((last - first + MUSIC_NOTE_FRAMES) % MUSIC_NOTE_FRAMES, (int)(1200 / frameInterval));
+  }
+
+  applyMusicState(false, 0);
+  int frozen = currentFrame;
+  runUntil(hostsim::nowUs() + 1000 * MS);
+  CHECK_EQ(currentFrame, frozen);
+  bool scheduled = false;
+  for (uint8_t i = 0; i < taskCount; i++) scheduled = scheduled || taskHeap[i].callback == advanceMusicNote;
+  CHECK(!scheduled);
+  currentState = IDLE;
+}
+
+// The idle face blinks once per eyeAnimInterval, with nothing else drawing it
+void testBlinks() {
+  uint64_t start = hostsim::nowUs();
+  int blinks = 0;
+  bool was = eyes.isAnimating();
+  runUntil(start + 5 * eyeAnimInterval * MS, [&]() {
+    if (eyes.isAnimating() && !was) blinks++;
+    was = eyes.isAnimating();
+  });
+  CHECK_EQ(blinks, 5);
+}
+
+}  // namespace
+
+int main() {
+  hostsim::seed(1);
+  hostsim::wireAdxlInt1(ADXL_INT_PIN);
+  hostsim::setPin(PIR_PIN, HIGH);  // someone at the desk, so the idle face stays awake
+  setup();
+  runUntil(2000 * MS);
+
+  testDecisions();
+  testIdleRate();
+  testExpressionRate();
+  testInputLatency();
+  testMusicNote();
+  testBlinks();
+  return hosttest::checkResult("pacer_test");
+}
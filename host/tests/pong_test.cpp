@@ -0,0 +1,141 @@
+// Pong determinism: from the same seed and the same encoder trace, play at
+// 20 fps, 200 fps and at jittery frame times goes through the same physics
+// ticks, checked every 50 ms when all of them have drawn a frame.
+//
+//   pong_test [--seed N]
+#include "DeskCompanionCode.ino.cpp"
+#include "HostSim.h"
+#include "check.h"
+
+namespace {
+
+const uint64_t GAME_US = 60000000;
+const uint64_t CHECKPOINT_US = 50000;  // every 20 fps frame, which the other rates draw too
+
+struct InputEvent {
+  uint64_t timeUs;
+  int encoder;  // 1 = left paddle, 2 = right paddle (two-player)
+  int direction;
+};
+
+struct Snapshot {
+  int32_t ballX, ballY, ballVelX, ballVelY, ballSpeed, leftPaddleY, rightPaddleY;
+  int leftScore, rightScore, state;
+  uint32_t rng;
+
+  bool operator==(const Snapshot& o) const {
+    return ballX == o.ballX && ballY == o.ballY && ballVelX == o.ballVelX && ballVelY == o.ballVelY &&
+           ballSpeed == o.ballSpeed && leftPaddleY == o.leftPaddleY && rightPaddleY == o.rightPaddleY &&
+           leftScore == o.leftScore && rightScore == o.rightScore && state == o.state && rng == o.rng;
+  }
+};
+
+uint32_t traceState;
+
+uint32_t traceRandom() {
+  traceState ^= traceState << 13;
+  traceState ^= traceState >> 17;
+  traceState ^= traceState << 5;
+  return traceState;
+}
+
+// A player twisting the encoder in bursts, at times that don't line up with ticks or frames
+std::vector<InputEvent> makeTrace(uint32_t seed, bool twoPlayer) {
+  traceState = seed * 2654435761u | 1;
+  std::vector<InputEvent> trace;
+  for (uint64_t t = 100000; t < GAME_US;) {
+    int encoder = twoPlayer && (traceRandom() & 1) ? 2 : 1;
+    int direction = (traceRandom() & 1) ? 1 : -1;
+    int burst = 1 + traceRandom() % 6;
+    for (int i = 0; i < burst; i++) {
+      if (traceRandom() % 4 == 0) direction = -direction;  // overshoot and correct
+      trace.push_back({ t, encoder, direction });
+      t += 7000 + traceRandom() % 23000;
+    }
+    t += traceRandom() % 400000;
+  }
+  return trace;
+}
+
+Snapshot snapshot() {
+  return { pongGame.ballX,       pongGame.ballY,        pongGame.ballVelX,  pongGame.ballVelY,
+           pongGame.ballSpeed,   pongGame.leftPaddleY,  pongGame.rightPaddleY,
+           pongGame.leftScore,   pongGame.rightScore,   (int)gameState,     pongGame.rng };
+}
+
+void advanceTo(uint64_t timeUs) {
+  if (timeUs > hostsim::nowUs()) hostsim::advance(timeUs - hostsim::nowUs());
+}
+
+// Plays the trace with frames at the times nextFrame() returns. Encoder steps are
+// handled when they happen, as the encoder interrupt wakes the loop for them.
+template <class NextFrame>
+std::vector<Snapshot> play(uint32_t seed, int mode, const std::vector<InputEvent>& trace, NextFrame nextFrame) {
+  advanceTo((hostsim::nowUs() / 1000000 + 1) * 1000000);  // every run starts on a whole second
+  uint64_t startUs = hostsim::nowUs();
+
+  hostsim::seed(seed);
+  currentState = GAMES;
+  gameMode = mode;
+  initializePongGame();
+  pongGame.gameActive = true;
+  gameState = GAME_PLAYING;
+
+  std::vector<Snapshot> checkpoints;
+  size_t nextInput = 0;
+  uint64_t frameUs = 0;
+  while (frameUs <= GAME_US) {
+    while (nextInput < trace.size() && trace[nextInput].timeUs <= frameUs) {
+      const InputEvent& e = trace[nextInput++];
+      advanceTo(startUs + e.timeUs);
+      if (e.encoder == 1) handleEncoder1Rotation(e.direction);
+      else handleEncoder2Rotation(e.direction);
+    }
+    advanceTo(startUs + frameUs);
+    updatePongGame();
+    if (frameUs % CHECKPOINT_US == 0) checkpoints.push_back(snapshot());
+    frameUs = nextFrame(frameUs);
+  }
+  return checkpoints;
+}
+
+void comparePlays(uint32_t seed, int mode) {
+  std::vector<InputEvent> trace = makeTrace(seed, mode == 2);
+  std::vector<Snapshot> at20 = play(seed, mode, trace, [](uint64_t t) { return t + 50000; });
+  std::vector<Snapshot> at200 = play(seed, mode, trace, [](uint64_t t) { return t + 5000; });
+
+  // Frames 1..60 ms apart, always landing on each checkpoint
+  uint32_t jitter = seed;
+  std::vector<Snapshot> jittered = play(seed, mode, trace, [&jitter](uint64_t t) {
+    jitter = jitter * 1664525u + 1013904223u;
+    uint64_t next = t + 1000 + (jitter >> 8) % 60000;
+    uint64_t checkpoint = (t / CHECKPOINT_US + 1) * CHECKPOINT_US;
+    return std::min(next, checkpoint);
+  });
+
+  CHECK_EQ(at20.size(), at200.size());
+  CHECK_EQ(jittered.size(), at200.size());
+  for (size_t i = 0; i < at200.size() && i < at20.size() && i < jittered.size(); i++) {
+    if (!CHECK(at20[i] == at200[i]) || !CHECK(jittered[i] == at200[i])) {
+      fprintf(stderr, "  mode %d seed %u: plays diverge by %.1f s\n", mode, seed, i * CHECKPOINT_US / 1e6);
+      return;
+    }
+  }
+
+  // Not trivially equal: the game moved, and a different seed plays differently
+  const Snapshot& last = at200.back();
+  CHECK(last.leftScore + last.rightScore > 0);
+  std::vector<Snapshot> other = play(seed + 1, mode, trace, [](uint64_t t) { return t + 5000; });
+  CHECK(!(other.back() == at200.back()));
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  uint32_t seed = 1;
+  if (argc > 2 && !strcmp(argv[1], "--seed")) seed = strtoul(argv[2], nullptr, 0);
+
+  comparePlays(seed, 1);  // against the AI
+  comparePlays(seed, 2);  // both paddles from the trace
+  return hosttest::checkResult("pong_test");
+}
@@ -0,0 +1,251 @@
+// Text protocol: each message the app sends decodes into the right state, and
+// mutations of those messages never leave a destination unterminated or a
+// count past its capacity.
+//
+//   protocol_test CORPUS [--seed N] [--mutations N]
+#include "DeskCompanionCode.ino.cpp"
+#include "HostSim.h"
+#include "check.h"
+#include "corpus.h"
+
+namespace {
+
+void send(const std::string& message) {
+  handleBleMessage(message.data(), message.size());
+}
+
+void resetProtocolState() {
+  numEvents = 0;
+  notificationHead = notificationSlots = notificationCount = 0;
+  notificationArenaTail = 0;
+  notificationScrollPos = 0;
+  showNotificationPopup = false;
+  currentState = IDLE;
+  clockSynced = false;
+  strcpy(currentSong, "No Music");
+  currentAlbum[0] = currentArtist[0] = '\0';
+  musicPlaying = false;
+  musicVolume = 50;
+  songDuration = 1000;
+  playbackPosition = 0;
+}
+
+// === Decoding ===
+void testTime() {
+  resetProtocolState();
+  send("TIME:09:05:07:042");
+  CHECK(clockSynced);
+  CHECK_EQ(clockAnchorMs, (int64_t)(((9 * 60 + 5) * 60 + 7) * 1000 + 42));
+
+  // Without milliseconds, as the firmware has always accepted
+  resetProtocolState();
+  send("TIME:23:59:59");
+  CHECK_EQ(clockAnchorMs, (int64_t)((23 * 60 + 59) * 60 + 59) * 1000);
+}
+
+void testMusic() {
+  resetProtocolState();
+  send("MUSIC_TRACK:Midnight City|Hurry Up, We're Dreaming|M83|243000");
+  CHECK_EQ(currentSong, "Midnight City");
+  CHECK_EQ(currentAlbum, "Hurry Up, We're Dreaming");
+  CHECK_EQ(currentArtist, "M83");
+  CHECK_EQ(songDuration, 243000);
+  CHECK_EQ(playbackPosition, 0);
+
+  send("MUSIC_STATE:true|61234");
+  CHECK(musicPlaying);
+  CHECK_EQ(playbackPosition, 61234);
+  send("MUSIC_STATE:false|999999");
+  CHECK(!musicPlaying);
+  CHECK_EQ(playbackPosition, 243000);  // clamped to the track
+
+  send("MUSIC_POS:98765");
+  CHECK_EQ(playbackPosition, 98765);
+
+  send("MUSIC_VOLUME:45");
+  CHECK_EQ(musicVolume, 45);
+  send("MUSIC_VOLUME:150");
+  CHECK_EQ(musicVolume, 100);
+
+  // An unknown duration still leaves a non-zero divisor for the seek bar
+  send("MUSIC_TRACK:Unknown|Unknown|Unknown|0");
+  CHECK_EQ(songDuration, 1);
+
+  send("MUSIC:Intro|xx|The xx|true|60|128000|5000");
+  CHECK_EQ(currentSong, "Intro");
+  CHECK_EQ(currentArtist, "The xx");
+  CHECK(musicPlaying);
+  CHECK_EQ(musicVolume, 60);
+  CHECK_EQ(songDuration, 128000);
+  CHECK_EQ(playbackPosition, 5000);
+
+  // Fields are views bounded by the message length, not by a terminator
+  std::string padded = "MUSIC_VOLUME:4567";
+  handleBleMessage(padded.data(), padded.size() - 2);
+  CHECK_EQ(musicVolume, 45);
+}
+
+void testNotifications() {
+  resetProtocolState();
+  send("NOTIFICATION:WhatsApp|Alice|See you at 5 | bring the charger");
+  CHECK_EQ(notificationCount, 1);
+  const Notification& n = notificationAt(0);
+  CHECK_EQ(notificationApp(n), "WhatsApp");
+  CHECK_EQ(notificationTitle(n), "Alice");
+  CHECK_EQ(notificationContent(n), "See you at 5 | bring the charger");
+  CHECK_EQ(currentNotification, "WhatsApp: Alice");
+
+  send("NOTIFICATION:Gmail||");
+  CHECK_EQ(notificationCount, 2);
+  CHECK_EQ(notificationTitle(notificationAt(1)), "");
+
+  // No app, or too few fields: dropped
+  send("NOTIFICATION:|Title|Body");
+  send("NOTIFICATION:App only");
+  CHECK_EQ(notificationCount, 2);
+
+  // Over-long UTF-8 text is cut on a character boundary
+  std::string title;
+  for (int i = 0; i < 40; i++) title += "é";
+  send("NOTIFICATION:App|" + title + "|Body");
+  const char* stored = notificationTitle(notificationAt(2));
+  CHECK(strlen(stored) < NOTIF_TITLE_MAX);
+  CHECK_EQ(strlen(stored) % 2, (size_t)0);
+  CHECK(title.compare(0, strlen(stored), stored) == 0);
+}
+
+void testEvents() {
+  resetProtocolState();
+  send("EVENTS:Standup(15m)|Deep work(50m)|Lunch(30m)");
+  CHECK_EQ(numEvents, 3);
+  CHECK_EQ(eventNames[1], "Deep work");
+  CHECK_EQ(eventDurations[1], 50);
+
+  // The name ends at the first '(', the duration at the first ')'
+  send("EVENTS:No duration|Unparsed duration(nullm)|Ok(5m)");
+  CHECK_EQ(numEvents, 2);
+  CHECK_EQ(eventNames[0], "Unparsed duration");
+  CHECK_EQ(eventDurations[0], 0);
+  CHECK_EQ(eventNames[1], "Ok");
+
+  send("EVENTS:A(1m)|B(2m)|C(3m)|D(4m)|E(5m)|F(6m)|G(7m)|H(8m)|I(9m)|J(10m)|K(11m)|L(12m)");
+  CHECK_EQ(numEvents, MAX_EVENTS);
+  CHECK_EQ(eventNames[MAX_EVENTS - 1], "J");
+}
+
+void testUnknown() {
+  resetProtocolState();
+  send("MUSIC_SHUFFLE:true");
+  send("");
+  send("TIME");
+  CHECK(!clockSynced);
+  CHECK_EQ(musicVolume, 50);
+}
+
+// === Fuzzing ===
+uint32_t fuzzState;
+
+uint32_t fuzzRandom() {
+  fuzzState ^= fuzzState << 13;
+  fuzzState ^= fuzzState >> 17;
+  fuzzState ^= fuzzState << 5;
+  return fuzzState;
+}
+
+// Bytes the decoder treats specially, plus UTF-8 lead and continuation bytes
+const char FUZZ_BYTES[] = { '|', ':', '(', ')', '-', '0', '9', 'm', '\0', '\n', (char)0xC3, (char)0xA9, (char)0xF0, (char)0x80 };
+
+std::string mutate(const std::string& seed, const std::vector<std::string>& corpus) {
+  std::string s = seed;
+  int edits = 1 + fuzzRandom() % 4;
+  for (int e = 0; e < edits; e++) {
+    size_t at = s.empty() ? 0 : fuzzRandom() % (s.size() + 1);
+    switch (fuzzRandom() % 6) {
+      case 0: s.resize(at); break;
+      case 1: if (at < s.size()) s[at] = (char)fuzzRandom(); break;
+      case 2: s.insert(at, 1, FUZZ_BYTES[fuzzRandom() % sizeof(FUZZ_BYTES)]); break;
+      case 3: s.erase(at, fuzzRandom() % 8); break;
+      case 4: s.insert(at, std::string(fuzzRandom() % 300, (char)('a' + fuzzRandom() % 26))); break;
+      case 5: {
+        const std::string& other = corpus[fuzzRandom() % corpus.size()];
+        s = s.substr(0, at) + other.substr(std::min(other.size(), (size_t)(fuzzRandom() % (other.size() + 1))));
+        break;
+      }
+    }
+  }
+  return s;
+}
+
+bool terminated(const char* text, size_t capacity) {
+  return memchr(text, '\0', capacity) != nullptr;
+}
+
+// Every destination stays terminated within its capacity and every count in range
+bool stateIsSound() {
+  bool ok = terminated(currentSong, MUSIC_TEXT_MAX) && terminated(currentAlbum, MUSIC_TEXT_MAX) &&
+            terminated(currentArtist, MUSIC_TEXT_MAX) &&
+            terminated(currentNotification, sizeof(currentNotification));
+  ok = ok && numEvents >= 0 && numEvents <= MAX_EVENTS;
+  for (int i = 0; ok && i < numEvents; i++) ok = terminated(eventNames[i], EVENT_NAME_MAX);
+
+  ok = ok && notificationCount >= 0 && notificationCount <= notificationSlots && notificationSlots <= MAX_NOTIFICATIONS;
+  ok = ok && notificationArenaTail <= NOTIF_ARENA_SIZE;
+  for (int i = 0; ok && i < notificationSlots; i++) {
+    const Notification& n = notifications[(notificationHead + i) % MAX_NOTIFICATIONS];
+    ok = n.offset + n.length <= NOTIF_ARENA_SIZE && notificationArena[n.offset + n.length - 1] == '\0' &&
+         strlen(notificationApp(n)) < NOTIF_APP_MAX && strlen(notificationTitle(n)) < NOTIF_TITLE_MAX &&
+         strlen(notificationContent(n)) < NOTIF_CONTENT_MAX;
+  }
+  return ok;
+}
+
+void fuzz(const std::vector<std::string>& corpus, uint32_t seed, int mutations) {
+  fuzzState = seed ? seed : 1;
+  resetProtocolState();
+  for (const std::string& message : corpus) {
+    send(message);
+    if (!CHECK(stateIsSound())) return;
+  }
+  for (const std::string& message : corpus) {
+    for (int i = 0; i < mutations; i++) {
+      std::string mutated = mutate(message, corpus);
+      send(mutated);
+      hostsim::clearSerialOutput();
+      if (!stateIsSound()) {
+        std::string hex;
+        char byte[5];
+        for (uint8_t b : mutated) {
+          snprintf(byte, sizeof(byte), "\\x%02x", b);
+          hex += byte;
+        }
+        fprintf(stderr, "unsound state after (seed %u): %s\n", seed, hex.c_str());
+        CHECK(stateIsSound());
+        return;
+      }
+    }
+  }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    fprintf(stderr, "usage: protocol_test CORPUS [--seed N] [--mutations N]\n");
+    return 2;
+  }
+  uint32_t seed = 1;
+  int mutations = 500;
+  for (int i = 2; i + 1 < argc; i += 2) {
+    if (!strcmp(argv[i], "--seed")) seed = strtoul(argv[i + 1], nullptr, 0);
+    else if (!strcmp(argv[i], "--mutations")) mutations = atoi(argv[i + 1]);
+  }
+  std::vector<std::string> corpus = hosttest::loadCorpus(argv[1]);
+
+  testTime();
+  testMusic();
+  testNotifications();
+  testEvents();
+  testUnknown();
+  fuzz(corpus, seed, mutations);
+  return hosttest::checkResult("protocol_test");
+}
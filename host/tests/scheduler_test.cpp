@@ -0,0 +1,302 @@
+// Task scheduler on explicit times: due tasks run in deadline order, periodic
+// tasks keep their phase however late they run, and callbacks may schedule and
+// cancel tasks, themselves included. A random workload checks the heap against
+// a sorted model.
+//
+//   scheduler_test [--seed N] [--operations N]
+#include "DeskCompanionCode.ino.cpp"
+#include "HostSim.h"
+#include "check.h"
+#include <algorithm>
+#include <climits>
+
+namespace {
+
+std::vector<int> ran;
+
+template <int N> void task() {
+  ran.push_back(N);
+}
+
+const TaskCallback TASKS[] = { task<0>, task<1>, task<2>, task<3>, task<4>,  task<5>,  task<6>,
+                               task<7>, task<8>, task<9>, task<10>, task<11>, task<12> };
+const int TASK_COUNT = sizeof(TASKS) / sizeof(TASKS[0]);
+
+int indexOf(TaskCallback callback) {
+  for (int i = 0; i < TASK_COUNT; i++) {
+    if (TASKS[i] == callback) return i;
+  }
+  return -1;
+}
+
+void reset() {
+  taskCount = 0;
+  ran.clear();
+}
+
+bool heapOrdered() {
+  for (uint8_t i = 1; i < taskCount; i++) {
+    if (taskBefore(taskHeap[i], taskHeap[(i - 1) / 2])) return false;
+  }
+  return true;
+}
+
+const ScheduledTask* find(TaskCallback callback) {
+  for (uint8_t i = 0; i < taskCount; i++) {
+    if (taskHeap[i].callback == callback) return &taskHeap[i];
+  }
+  return nullptr;
+}
+
+// === Ordering ===
+void testOrdering() {
+  reset();
+  const unsigned long deadlines[] = { 500, 120, 900, 40, 310, 700, 80, 260 };
+  for (int i = 0; i < 8; i++) scheduleTaskAt(TASKS[i], deadlines[i], 0);
+  CHECK(heapOrdered());
+  CHECK_EQ(taskHeap[0].deadline, 40ul);  // what the pacer sleeps until
+
+  // Nothing before its deadline, everything due at once in deadline order
+  runDueTasks(39);
+  CHECK(ran.empty());
+  runDueTasks(300);
+  CHECK(ran == std::vector<int>({ 3, 6, 1, 7 }));
+  CHECK_EQ(taskHeap[0].deadline, 310ul);
+  runDueTasks(10000);
+  CHECK(ran == std::vector<int>({ 3, 6, 1, 7, 4, 0, 5, 2 }));
+  CHECK_EQ(taskCount, 0);
+
+  // A task is due at its deadline exactly
+  scheduleTaskAt(TASKS[0], 10100, 0);
+  runDueTasks(10100);
+  CHECK_EQ(ran.back(), 0);
+
+  // Deadlines across the millis() wrap compare by distance, not by value
+  reset();
+  scheduleTaskAt(TASKS[0], ULONG_MAX - 15, 0);
+  scheduleTaskAt(TASKS[1], 0x10, 0);
+  CHECK(taskHeap[0].callback == TASKS[0]);
+  runDueTasks(ULONG_MAX - 7);
+  CHECK(ran == std::vector<int>({ 0 }));
+  runDueTasks(0x10);
+  CHECK(ran == std::vector<int>({ 0, 1 }));
+
+  // A full heap drops further tasks and keeps the ones it has
+  reset();
+  for (int i = 0; i < TASK_COUNT; i++) scheduleTaskAt(TASKS[i], 1000 - i, 0);
+  CHECK_EQ(taskCount, MAX_SCHEDULED_TASKS);
+  CHECK(find(TASKS[MAX_SCHEDULED_TASKS]) == nullptr);
+  reset();
+}
+
+// === Periodic Phase ===
+// Run late by varying amounts: every deadline stays on start + k * period, missed
+// periods are skipped rather than run back to back, and none runs early
+void testPeriodicPhase() {
+  reset();
+  const unsigned long start = 1000, period = 40;
+  scheduleTaskAt(TASKS[0], start, period);
+  scheduleTaskAt(TASKS[1], start + 7, 250);
+
+  unsigned long now = start;
+  uint32_t jitter = 12345;
+  for (int pass = 0; pass < 2000; pass++) {
+    jitter = jitter * 1664525u + 1013904223u;
+    now += 1 + (jitter >> 8) % 130;  // up to three periods late
+    size_t before = ran.size();
+    runDueTasks(now);
+
+    int runs = std::count(ran.begin() + before, ran.end(), 0);
+    if (!CHECK(runs <= 1)) return;
+    const ScheduledTask* t = find(TASKS[0]);
+    if (!CHECK(t != nullptr)) return;
+    if (!CHECK((t->deadline - start) % period == 0 && t->deadline > now && t->deadline <= now + period)) {
+      fprintf(stderr, "  at %lu: next deadline %lu\n", now, (unsigned long)t->deadline);
+      return;
+    }
+    const ScheduledTask* other = find(TASKS[1]);
+    CHECK((other->deadline - start - 7) % 250 == 0 && other->deadline > now);
+  }
+  CHECK(heapOrdered());
+
+  // On time, it runs once per period
+  reset();
+  scheduleTaskAt(TASKS[0], start, period);
+  for (unsigned long t = start; t < start + 100 * period; t++) runDueTasks(t);
+  CHECK_EQ(ran.size(), (size_t)100);
+  reset();
+}
+
+// === Rescheduling ===
+int selfRuns = 0;
+
+// Reschedules itself one-shot with a growing delay, as the faces do
+void backoff() {
+  selfRuns++;
+  if (selfRuns < 4) scheduleTaskAt(backoff, 2000 + selfRuns * 100, 0);
+}
+
+// Cancels a task due at the same time, and moves a periodic one
+void canceller() {
+  ran.push_back(100);
+  cancelTask(TASKS[1]);
+  scheduleTaskAt(TASKS[2], 5000, 0);
+}
+
+// A periodic task that stops itself
+void lastRun() {
+  ran.push_back(200);
+  cancelTask(lastRun);
+}
+
+void testRescheduling() {
+  // Scheduling a callback again moves it instead of adding a second entry
+  reset();
+  scheduleTaskAt(TASKS[0], 100, 0);
+  scheduleTaskAt(TASKS[0], 300, 50);
+  CHECK_EQ(taskCount, 1);
+  CHECK_EQ(taskHeap[0].deadline, 300ul);
+  CHECK_EQ(taskHeap[0].period, 50ul);
+  runDueTasks(299);
+  CHECK(ran.empty());
+
+  // scheduleTask counts the delay from millis()
+  reset();
+  hostsim::advance(1234 * 1000);
+  scheduleTask(TASKS[0], 250, 0);
+  CHECK_EQ(taskHeap[0].deadline, millis() + 250);
+
+  // A callback rescheduling itself from inside runDueTasks
+  reset();
+  selfRuns = 0;
+  scheduleTaskAt(backoff, 2000, 0);
+  runDueTasks(2099);
+  CHECK_EQ(selfRuns, 1);
+  runDueTasks(10000);
+  CHECK_EQ(selfRuns, 4);
+  CHECK_EQ(taskCount, 0);
+
+  // A callback cancelling a task that is due in the same call
+  reset();
+  scheduleTaskAt(canceller, 3000, 0);
+  scheduleTaskAt(TASKS[1], 3001, 0);
+  scheduleTaskAt(TASKS[2], 3002, 100);
+  runDueTasks(3500);
+  CHECK(ran == std::vector<int>({ 100 }));
+  CHECK_EQ(taskCount, 1);
+  CHECK_EQ(taskHeap[0].deadline, 5000ul);
+  CHECK_EQ(taskHeap[0].period, 0ul);
+
+  // A periodic callback cancelling itself is not put back
+  reset();
+  scheduleTaskAt(lastRun, 4000, 10);
+  runDueTasks(4100);
+  CHECK(ran == std::vector<int>({ 200 }));
+  CHECK_EQ(taskCount, 0);
+  reset();
+}
+
+// === Random Workload ===
+struct ModelTask {
+  unsigned long deadline, period;
+};
+
+uint32_t randomState;
+
+uint32_t nextRandom() {
+  randomState ^= randomState << 13;
+  randomState ^= randomState >> 17;
+  randomState ^= randomState << 5;
+  return randomState;
+}
+
+// Scheduling, cancelling and running at random against a model: the same tasks
+// run, in deadline order, and the heap holds the model's deadlines
+void testRandomWorkload(uint32_t seed, long operations) {
+  reset();
+  randomState = seed ? seed : 1;
+  ModelTask model[TASK_COUNT];
+  bool scheduled[TASK_COUNT] = {};
+  unsigned long now = ULONG_MAX - 0xFFFF;  // passes the millis() wrap on the way
+
+  for (long op = 0; op < operations; op++) {
+    int i = nextRandom() % TASK_COUNT;
+    switch (nextRandom() % 4) {
+      case 0:
+      case 1: {
+        int live = std::count(scheduled, scheduled + TASK_COUNT, true);
+        if (!scheduled[i] && live == MAX_SCHEDULED_TASKS) break;
+        unsigned long period = nextRandom() % 3 ? 0 : 1 + nextRandom() % 500;
+        model[i] = { now + nextRandom() % 1000, period };
+        scheduled[i] = true;
+        scheduleTaskAt(TASKS[i], model[i].deadline, period);
+        break;
+      }
+      case 2:
+        scheduled[i] = false;
+        cancelTask(TASKS[i]);
+        break;
+      case 3: {
+        now += nextRandom() % 300;
+        // Expected runs, in deadline order; distinct deadlines keep the order unique
+        std::vector<std::pair<long, int>> due;
+        for (int t = 0; t < TASK_COUNT; t++) {
+          if (!scheduled[t] || (long)(now - model[t].deadline) < 0) continue;
+          due.push_back({ (long)(model[t].deadline - now), t });
+          if (model[t].period) {
+            model[t].deadline += ((now - model[t].deadline) / model[t].period + 1) * model[t].period;
+          } else {
+            scheduled[t] = false;
+          }
+        }
+        std::sort(due.begin(), due.end());
+        bool distinct = std::adjacent_find(due.begin(), due.end(), [](const auto& a, const auto& b) {
+                          return a.first == b.first;
+                        }) == due.end();
+
+        ran.clear();
+        runDueTasks(now);
+        std::vector<int> expected;
+        for (const auto& d : due) expected.push_back(d.second);
+        std::vector<int> got = ran;
+        if (!distinct) {
+          std::sort(expected.begin(), expected.end());
+          std::sort(got.begin(), got.end());
+        }
+        if (!CHECK(got == expected)) {
+          fprintf(stderr, "  run at %lu, operation %ld (seed %u)\n", now, op, seed);
+          return;
+        }
+        break;
+      }
+    }
+
+    bool matches = heapOrdered() && taskCount == std::count(scheduled, scheduled + TASK_COUNT, true);
+    for (uint8_t h = 0; h < taskCount && matches; h++) {
+      int t = indexOf(taskHeap[h].callback);
+      matches = t >= 0 && scheduled[t] && taskHeap[h].deadline == model[t].deadline;
+    }
+    if (!CHECK(matches)) {
+      fprintf(stderr, "  heap differs from the model after operation %ld (seed %u)\n", op, seed);
+      return;
+    }
+  }
+  reset();
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  uint32_t seed = 1;
+  long operations = 100000;
+  for (int i = 1; i + 1 < argc; i += 2) {
+    if (!strcmp(argv[i], "--seed")) seed = strtoul(argv[i + 1], nullptr, 0);
+    else if (!strcmp(argv[i], "--operations")) operations = atol(argv[i + 1]);
+  }
+
+  testOrdering();
+  testPeriodicPhase();
+  testRescheduling();
+  testRandomWorkload(seed, operations);
+  return hosttest::checkResult("scheduler_test");
+}
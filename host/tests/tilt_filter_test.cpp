@@ -0,0 +1,156 @@
+// Tilt low-pass over the ADXL345 FIFO: a sample fixture drained in the same
+// 4-sample batches sampleTilt() sees at 25 Hz must give the fixture's filter
+// output, and its step and frequency response must be those of a one-pole low-pass.
+//
+//   tilt_filter_test FIXTURE
+#include "DeskCompanionCode.ino.cpp"
+#include "HostSim.h"
+#include "check.h"
+#include <fstream>
+#include <sstream>
+
+namespace {
+
+const double TOLERANCE = 1e-4;
+const int SAMPLES_PER_DRAIN = 4;  // accelReadInterval at the 25 Hz output rate
+const double SAMPLE_RATE_HZ = 25;
+const double G_PER_LSB = ADXL345_MG2G_MULTIPLIER;
+
+struct Row {
+  int16_t x, y, z;
+  float filteredX, filteredY;
+};
+
+std::vector<Row> loadFixture(const char* path) {
+  std::ifstream in(path);
+  if (!in) {
+    fprintf(stderr, "cannot read fixture %s\n", path);
+    exit(2);
+  }
+  std::vector<Row> rows;
+  std::string line;
+  while (std::getline(in, line)) {
+    if (line.empty() || line[0] == '#') continue;
+    std::istringstream fields(line);
+    Row r;
+    if (fields >> r.x >> r.y >> r.z >> r.filteredX >> r.filteredY) rows.push_back(r);
+  }
+  return rows;
+}
+
+void resetFilter() {
+  filteredTiltX = filteredTiltY = 0;
+  tiltX = tiltY = 0;
+}
+
+uint8_t fifoEntries() {
+  return adxl.readRegister(ADXL345_REG_FIFO_STATUS) & ADXL_FIFO_ENTRIES_MASK;
+}
+
+double stddev(const std::vector<double>& values) {
+  double mean = 0, sq = 0;
+  for (double v : values) mean += v;
+  mean /= values.size();
+  for (double v : values) sq += (v - mean) * (v - mean);
+  return sqrt(sq / values.size());
+}
+
+void testFixture(const std::vector<Row>& rows) {
+  resetFilter();
+  std::vector<double> rawRest, filteredRest;
+  for (size_t i = 0; i < rows.size(); i += SAMPLES_PER_DRAIN) {
+    std::vector<std::vector<int16_t>> batch;
+    for (size_t j = i; j < std::min(rows.size(), i + SAMPLES_PER_DRAIN); j++) {
+      batch.push_back({ rows[j].x, rows[j].y, rows[j].z });
+    }
+    hostsim::queueAccelSamples(batch);
+    sampleTilt();
+    CHECK_EQ(fifoEntries(), 0);
+
+    const Row& last = rows[i + batch.size() - 1];
+    if (!CHECK(fabs(filteredTiltX - last.filteredX) < TOLERANCE && fabs(filteredTiltY - last.filteredY) < TOLERANCE)) {
+      fprintf(stderr, "  after sample %zu: %.6f %.6f, expected %.6f %.6f\n", i + batch.size() - 1, filteredTiltX,
+              filteredTiltY, last.filteredX, last.filteredY);
+      return;
+    }
+    // The eyes follow the filter once it moves by more than TILT_EPSILON
+    CHECK(fabs(tiltX - filteredTiltX) <= TILT_EPSILON && fabs(tiltY - filteredTiltY) <= TILT_EPSILON);
+
+    // Upright and still for the first two seconds, after the filter settled
+    if (i >= 12 && i + SAMPLES_PER_DRAIN <= 2 * SAMPLE_RATE_HZ) {
+      rawRest.push_back(last.x * G_PER_LSB);
+      filteredRest.push_back(filteredTiltX);
+    }
+  }
+
+  // Sensor noise at rest is at least halved
+  CHECK(stddev(filteredRest) < 0.5 * stddev(rawRest));
+
+  // Tipped forward 25 degrees from 2.4 s on: settled by 4 s
+  const Row& held = rows[(size_t)(4 * SAMPLE_RATE_HZ)];
+  CHECK(fabs(held.filteredX - sin(25 * M_PI / 180)) < 0.02);
+}
+
+// One-pole response to a 0.5 g step on X, drained one sample at a time
+void testStepResponse() {
+  resetFilter();
+  const float step = 0.5;
+  const double alpha = TILT_FILTER_ALPHA;
+  float previous = 0;
+  int samplesTo90 = 0;
+  for (int n = 1; n <= 25; n++) {
+    hostsim::queueAccelSamples({ { (int16_t)lround(step / G_PER_LSB), 0, 0 } });
+    drainAccelFifo();
+    double expected = step * (1 - pow(1 - alpha, n));
+    if (!CHECK(fabs(filteredTiltX - expected) < TOLERANCE)) {
+      fprintf(stderr, "  sample %d: %.6f, expected %.6f\n", n, filteredTiltX, expected);
+      return;
+    }
+    CHECK(filteredTiltX >= previous && filteredTiltX <= step);  // no overshoot
+    if (!samplesTo90 && filteredTiltX >= 0.9f * step) samplesTo90 = n;
+    previous = filteredTiltX;
+  }
+  // 90% in 7 samples: 280 ms at 25 Hz
+  CHECK_EQ(samplesTo90, 7);
+  CHECK_EQ(filteredTiltY, 0.0f);
+}
+
+// Peak output over the last two seconds of a sine on X, seen after every sample
+double gainAt(double frequencyHz) {
+  resetFilter();
+  const double amplitude = 0.4;
+  const int samples = 10 * SAMPLE_RATE_HZ;
+  double peak = 0;
+  for (int n = 0; n < samples; n++) {
+    double g = amplitude * sin(2 * M_PI * frequencyHz * n / SAMPLE_RATE_HZ);
+    hostsim::queueAccelSamples({ { (int16_t)lround(g / G_PER_LSB), 0, 0 } });
+    drainAccelFifo();
+    if (n >= samples - 2 * SAMPLE_RATE_HZ) peak = std::max(peak, fabs((double)filteredTiltX));
+  }
+  return peak / amplitude;
+}
+
+void testFrequencyResponse() {
+  // Slow posture changes pass, hand tremor and footsteps don't
+  CHECK(gainAt(0.5) > 0.9);
+  CHECK(gainAt(6) < 0.35);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    fprintf(stderr, "usage: tilt_filter_test FIXTURE\n");
+    return 2;
+  }
+  std::vector<Row> rows = loadFixture(argv[1]);
+  CHECK(!rows.empty());
+
+  setupSensors();
+  CHECK(accelReady);
+
+  testFixture(rows);
+  testStepResponse();
+  testFrequencyResponse();
+  return hosttest::checkResult("tilt_filter_test");
+}
@@ -0,0 +1,69 @@
+#!/usr/bin/env python3
+"""Turn DeskCompanionCode.ino into a C++ translation unit the way the Arduino
+builder does: include Arduino.h, then declare every top-level function right
+before the first function definition so the sketch can call functions defined
+further down. #line directives keep compiler errors pointing into the .ino."""
+import re
+import sys
+
+SIGNATURE = re.compile(
+    r'^((?:static\s+|inline\s+)*[A-Za-z_][\w:<>\*\s&]*?[\s\*&]+)'
+    r'([A-Za-z_]\w*)\s*\(([^;{]*)\)\s*\{\s*(//.*)?$')
+NOT_A_FUNCTION = re.compile(r'^(if|for|while|switch|class|struct|else|return|enum|do)\b')
+
+
+def strip_defaults(args):
+    # void f(int a, bool b = true) -> void f(int a, bool b)
+    return re.sub(r'\s*=\s*[^,]+', '', args)
+
+
+def main(src_path, out_path):
+    with open(src_path) as f:
+        lines = f.read().split('\n')
+
+    prototypes = []
+    first = None
+    depth = 0
+    in_comment = False
+    for i, line in enumerate(lines):
+        code = line
+        if in_comment:
+            if '*/' not in code:
+                continue
+            code = code.split('*/', 1)[1]
+            in_comment = False
+        code = re.sub(r'/\*.*?\*/', '', code)
+        if '/*' in code:
+            code, in_comment = code.split('/*', 1)[0], True
+
+        if depth == 0 and not code.startswith('#'):
+            m = SIGNATURE.match(code)
+            if m and not NOT_A_FUNCTION.match(code.strip()):
+                if first is None:
+                    first = i
+                name = m.group(2)
+                # setup()/loop() are declared by Arduino.h; ISRs carry their own prototypes
+                if name not in ('setup', 'loop') and 'IRAM_ATTR' not in m.group(1):
+                    prototypes.append(m.group(1) + name + '(' + strip_defaults(m.group(3)) + ');')
+
+        # Braces inside strings and char literals don't count
+        bare = re.sub(r'"(\\.|[^"\\])*"|\'(\\.|[^\'\\])*\'', '', code.split('//', 1)[0])
+        depth += bare.count('{') - bare.count('}')
+
+    if first is None:
+        sys.exit('%s: no function definitions found' % src_path)
+
+    name = src_path.replace('\\', '/')
+    with open(out_path, 'w') as out:
+        out.write('#include <Arduino.h>\n')
+        out.write('#line 1 "%s"\n' % name)
+        out.write('\n'.join(lines[:first]) + '\n')
+        out.write('\n'.join(prototypes) + '\n')
+        out.write('#line %d "%s"\n' % (first + 1, name))
+        out.write('\n'.join(lines[first:]) + '\n')
+
+
+if __name__ == '__main__':
+    if len(sys.argv) != 3:
+        sys.exit('usage: sketch_to_cpp.py <sketch.ino> <out.cpp>')
+    main(sys.argv[1], sys.argv[2])